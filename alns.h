@@ -0,0 +1,408 @@
+#ifndef ALNS_H
+#define ALNS_H
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <cmath>
+#include <climits>
+#include "solution.h"
+
+// Melhor solução compartilhada entre as buscas paralelas, no formato 0 c1 c2 0 c3 0 ...
+class SharedBest {
+public:
+    std::mutex mutex;
+    std::vector<int> path;
+    int cost = INT_MAX;
+
+    void offer(const std::vector<int>& candidate, int candidate_cost) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (candidate_cost < cost) {
+            path = candidate;
+            cost = candidate_cost;
+        }
+    }
+
+    // Copia a melhor solução se ela for melhor que 'known_cost'.
+    bool fetchIfBetter(int known_cost, std::vector<int>& out, int& out_cost) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cost >= known_cost) {
+            return false;
+        }
+        out = path;
+        out_cost = cost;
+        return true;
+    }
+};
+
+// Listas de candidatos: para cada cidade, as K cidades mais próximas. Calculadas uma vez e
+// compartilhadas (somente leitura) por todas as threads.
+template <typename Net>
+std::vector<std::vector<int>> nearestNeighbors(const Net& network, int k) {
+    int n = network.total_nodes;
+    std::vector<std::vector<int>> neighbors(n);
+    std::vector<std::pair<int, int>> order;
+    for (int i = 1; i < n; ++i) {
+        order.clear();
+        for (int j = 1; j < n; ++j) {
+            if (j != i) order.emplace_back(network.distance(i, j), j);
+        }
+        size_t keep = std::min<size_t>(k, order.size());
+        std::partial_sort(order.begin(), order.begin() + keep, order.end());
+        for (size_t t = 0; t < keep; ++t) {
+            neighbors[i].push_back(order[t].second);
+        }
+    }
+    return neighbors;
+}
+
+// Busca adaptativa em grandes vizinhanças (ALNS): a cada iteração remove um subconjunto de clientes
+// (aleatório, de pior custo ou relacionados) e os reinsere (gulosa ou por arrependimento), aceitando o
+// resultado por recozimento simulado. Os pesos dos operadores se adaptam ao sucesso de cada um.
+// As restrições são as do Clarke e Wright do ex2: carga <= capacidade e rota + 2 visitas ao depósito
+// <= max_visits. As inserções só consideram as rotas dos vizinhos mais próximos e uma rota vazia.
+template <typename Net>
+class ALNS {
+public:
+    enum { REMOVE_RANDOM, REMOVE_WORST, REMOVE_RELATED, REMOVALS };
+    enum { INSERT_GREEDY, INSERT_REGRET, INSERTIONS };
+
+    const Net& network;
+    const std::vector<std::vector<int>>& neighbors;
+    int max_capacity;
+    int max_visits;
+    int total_nodes;
+    std::mt19937 rng;
+
+    IntArena arena; // Um bloco para as três soluções
+    Solution current, candidate, best;
+
+    double removal_weight[REMOVALS] = {1, 1, 1};
+    double insertion_weight[INSERTIONS] = {1, 1};
+    double removal_score[REMOVALS] = {};
+    double insertion_score[INSERTIONS] = {};
+    int removal_uses[REMOVALS] = {};
+    int insertion_uses[INSERTIONS] = {};
+
+    long long iterations = 0;
+    int segment_length = 100;
+    int sync_interval = 200;
+
+    // Melhor inserção conhecida de um cliente removido (e a segunda melhor em outra rota)
+    struct Insertion {
+        int delta = INT_MAX;
+        int route = -1;
+        int after = 0;
+        int second_delta = INT_MAX;
+        int second_route = -1;
+    };
+    std::vector<int> removed;
+    std::vector<Insertion> cache;
+    std::vector<int> route_seen;
+    int empty_cursor = 1;
+
+    ALNS(const Net& net, const std::vector<std::vector<int>>& near, int cap, int visits, unsigned seed)
+        : network(net), neighbors(near), max_capacity(cap), max_visits(visits), total_nodes(net.total_nodes), rng(seed) {
+        arena.reserve(3 * Solution::footprint(total_nodes));
+        current.attach(arena, total_nodes);
+        candidate.attach(arena, total_nodes);
+        best.attach(arena, total_nodes);
+        route_seen.assign(total_nodes, -1);
+    }
+
+    int demand(int node) const {
+        return network.nodes[node].requirement;
+    }
+
+    bool fits(const Solution& solution, int r, int node) const {
+        return solution.load[r] + demand(node) <= max_capacity && solution.size[r] + 1 + 2 <= max_visits;
+    }
+
+    int emptyRoute(const Solution& solution) {
+        for (int k = 0; k < total_nodes; ++k) {
+            if (empty_cursor >= total_nodes) empty_cursor = 1;
+            if (solution.size[empty_cursor] == 0) return empty_cursor;
+            ++empty_cursor;
+        }
+        return -1;
+    }
+
+    // Remoção aleatória
+    void removeRandom(Solution& solution, int count) {
+        std::uniform_int_distribution<int> pick(1, total_nodes - 1);
+        while (static_cast<int>(removed.size()) < count) {
+            int node = pick(rng);
+            if (solution.route_id[node] != 0) {
+                solution.remove(node, network, demand(node));
+                removed.push_back(node);
+            }
+        }
+    }
+
+    // Remoção dos clientes cuja saída mais reduz o custo, com sorteio enviesado para diversificar
+    void removeWorst(Solution& solution, int count) {
+        std::vector<std::pair<int, int>> gains;
+        gains.reserve(total_nodes);
+        for (int node = 1; node < total_nodes; ++node) {
+            if (solution.route_id[node] == 0) continue;
+            int p = solution.prev[node], n = solution.next[node];
+            gains.emplace_back(network.distance(p, node) + network.distance(node, n) - network.distance(p, n), node);
+        }
+        std::sort(gains.begin(), gains.end(), std::greater<std::pair<int, int>>());
+
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        while (static_cast<int>(removed.size()) < count && !gains.empty()) {
+            size_t index = static_cast<size_t>(std::pow(uniform(rng), 3.0) * gains.size());
+            index = std::min(index, gains.size() - 1);
+            int node = gains[index].second;
+            gains.erase(gains.begin() + index);
+            solution.remove(node, network, demand(node));
+            removed.push_back(node);
+        }
+    }
+
+    // Remoção de clientes próximos entre si: parte de uma semente e segue as listas de vizinhos
+    void removeRelated(Solution& solution, int count) {
+        std::uniform_int_distribution<int> pick(1, total_nodes - 1);
+        int seed = pick(rng);
+        solution.remove(seed, network, demand(seed));
+        removed.push_back(seed);
+
+        for (size_t frontier = 0; frontier < removed.size() && static_cast<int>(removed.size()) < count; ++frontier) {
+            for (int node : neighbors[removed[frontier]]) {
+                if (static_cast<int>(removed.size()) >= count) break;
+                if (solution.route_id[node] != 0) {
+                    solution.remove(node, network, demand(node));
+                    removed.push_back(node);
+                }
+            }
+        }
+        removeRandom(solution, count);
+    }
+
+    // Melhor posição do cliente na rota r, ou INT_MAX se ele não cabe nela
+    int bestInRoute(const Solution& solution, int r, int node, int& best_after) const {
+        if (!fits(solution, r, node)) {
+            return INT_MAX;
+        }
+        int best_delta = INT_MAX;
+        int after = 0;
+        do {
+            int delta = solution.insertionDelta(r, after, node, network);
+            if (delta < best_delta) {
+                best_delta = delta;
+                best_after = after;
+            }
+            after = after == 0 ? solution.head[r] : solution.next[after];
+        } while (solution.size[r] > 0 && after != 0);
+        return best_delta;
+    }
+
+    void consider(Insertion& entry, int r, int delta, int after) const {
+        if (delta == INT_MAX) return;
+        if (delta < entry.delta) {
+            if (entry.route != r) {
+                entry.second_delta = entry.delta;
+                entry.second_route = entry.route;
+            }
+            entry.delta = delta;
+            entry.route = r;
+            entry.after = after;
+        } else if (r != entry.route && delta < entry.second_delta) {
+            entry.second_delta = delta;
+            entry.second_route = r;
+        }
+    }
+
+    // Avalia as rotas candidatas do cliente: as dos vizinhos e uma rota vazia
+    void evaluate(const Solution& solution, int node, int empty, Insertion& entry) {
+        entry = Insertion{};
+        for (int neighbor : neighbors[node]) {
+            int r = solution.route_id[neighbor];
+            if (r == 0 || route_seen[r] == node) continue;
+            route_seen[r] = node;
+            int after = 0;
+            int delta = bestInRoute(solution, r, node, after);
+            consider(entry, r, delta, after);
+        }
+        for (int neighbor : neighbors[node]) {
+            int r = solution.route_id[neighbor];
+            if (r != 0) route_seen[r] = -1;
+        }
+        if (empty != -1) {
+            int after = 0;
+            consider(entry, empty, bestInRoute(solution, empty, node, after), after);
+        }
+    }
+
+    // Reinsere os removidos um a um; a cada passo escolhe o de menor custo (gulosa) ou o de maior
+    // arrependimento entre a melhor e a segunda melhor rota. Após cada inserção só a rota alterada
+    // é reavaliada para os demais, a menos que ela fosse a melhor ou a segunda melhor de algum.
+    void reinsert(Solution& solution, bool regret) {
+        int empty = emptyRoute(solution);
+        cache.resize(removed.size());
+        for (size_t k = 0; k < removed.size(); ++k) {
+            evaluate(solution, removed[k], empty, cache[k]);
+        }
+
+        while (!removed.empty()) {
+            size_t chosen = 0;
+            long long chosen_key = LLONG_MIN;
+            for (size_t k = 0; k < removed.size(); ++k) {
+                const auto& entry = cache[k];
+                long long key;
+                if (regret) {
+                    long long second = entry.second_route == -1 ? INT_MAX : entry.second_delta;
+                    key = (second - entry.delta) * 2 - entry.delta;
+                } else {
+                    key = -static_cast<long long>(entry.delta);
+                }
+                if (key > chosen_key) {
+                    chosen_key = key;
+                    chosen = k;
+                }
+            }
+
+            int node = removed[chosen];
+            Insertion entry = cache[chosen];
+            if (entry.route == -1) {
+                entry.route = empty != -1 ? empty : emptyRoute(solution); // Nenhuma rota comporta: rota própria
+                entry.after = 0;
+            }
+            int r = entry.route;
+            bool opened = solution.size[r] == 0;
+            solution.insertAfter(r, entry.after, node, network, demand(node));
+
+            removed[chosen] = removed.back();
+            removed.pop_back();
+            cache[chosen] = cache.back();
+            cache.pop_back();
+
+            if (opened) {
+                empty = emptyRoute(solution);
+            }
+            for (size_t k = 0; k < removed.size(); ++k) {
+                Insertion& other = cache[k];
+                if (other.route == r || other.second_route == r || opened) {
+                    evaluate(solution, removed[k], empty, other);
+                } else {
+                    int after = 0;
+                    consider(other, r, bestInRoute(solution, r, removed[k], after), after);
+                }
+            }
+        }
+    }
+
+    int roulette(const double* weights, int count) {
+        double total = 0;
+        for (int k = 0; k < count; ++k) total += weights[k];
+        double pick = std::uniform_real_distribution<double>(0.0, total)(rng);
+        for (int k = 0; k < count; ++k) {
+            pick -= weights[k];
+            if (pick <= 0) return k;
+        }
+        return count - 1;
+    }
+
+    void updateWeights() {
+        const double reaction = 0.1;
+        for (int k = 0; k < REMOVALS; ++k) {
+            if (removal_uses[k] > 0) {
+                removal_weight[k] = (1 - reaction) * removal_weight[k] + reaction * removal_score[k] / removal_uses[k];
+            }
+            removal_weight[k] = std::max(removal_weight[k], 0.05);
+            removal_score[k] = 0;
+            removal_uses[k] = 0;
+        }
+        for (int k = 0; k < INSERTIONS; ++k) {
+            if (insertion_uses[k] > 0) {
+                insertion_weight[k] = (1 - reaction) * insertion_weight[k] + reaction * insertion_score[k] / insertion_uses[k];
+            }
+            insertion_weight[k] = std::max(insertion_weight[k], 0.05);
+            insertion_score[k] = 0;
+            insertion_uses[k] = 0;
+        }
+    }
+
+    // Executa até o prazo a partir de 'start', trocando a melhor solução com as outras threads
+    // a cada sync_interval iterações. Ao final 'best' guarda a melhor solução desta busca.
+    void run(const Solution& start, SharedBest& shared, double time_limit) {
+        current.copyFrom(start);
+        best.copyFrom(start);
+        int current_cost = current.totalCost();
+        int best_cost = current_cost;
+
+        int customers = total_nodes - 1;
+        int min_remove = std::min(4, customers);
+        int max_remove = std::max(min_remove, std::min(100, customers * 4 / 10));
+
+        // Temperatura inicial: uma piora de 0,1% é aceita com probabilidade 1/2; esfria até 1% disso
+        double initial_temperature = std::max(1.0, 0.001 * current_cost / std::log(2.0));
+        double final_temperature = initial_temperature * 0.01;
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        auto begin = std::chrono::steady_clock::now();
+        while (true) {
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            if (elapsed >= time_limit || customers < 2) {
+                break;
+            }
+            double temperature = initial_temperature * std::pow(final_temperature / initial_temperature, elapsed / time_limit);
+
+            candidate.copyFrom(current);
+            int removal = roulette(removal_weight, REMOVALS);
+            int insertion = roulette(insertion_weight, INSERTIONS);
+            int count = std::uniform_int_distribution<int>(min_remove, max_remove)(rng);
+
+            removed.clear();
+            if (removal == REMOVE_RANDOM) removeRandom(candidate, count);
+            else if (removal == REMOVE_WORST) removeWorst(candidate, count);
+            else removeRelated(candidate, count);
+            reinsert(candidate, insertion == INSERT_REGRET);
+
+            int candidate_cost = candidate.totalCost();
+            double score = 0;
+            if (candidate_cost < best_cost) {
+                best.copyFrom(candidate);
+                best_cost = candidate_cost;
+                score = 33;
+            } else if (candidate_cost < current_cost) {
+                score = 9;
+            }
+
+            bool accept = candidate_cost <= current_cost ||
+                          uniform(rng) < std::exp((current_cost - candidate_cost) / temperature);
+            if (accept) {
+                current.copyFrom(candidate);
+                if (score == 0 && candidate_cost != current_cost) score = 13;
+                current_cost = candidate_cost;
+            }
+
+            removal_score[removal] += score;
+            insertion_score[insertion] += score;
+            ++removal_uses[removal];
+            ++insertion_uses[insertion];
+
+            ++iterations;
+            if (iterations % segment_length == 0) {
+                updateWeights();
+            }
+            if (iterations % sync_interval == 0) {
+                shared.offer(best.toPath(), best_cost);
+                std::vector<int> path;
+                int shared_cost;
+                if (shared.fetchIfBetter(best_cost, path, shared_cost)) {
+                    best.fromPath(path, network);
+                    current.copyFrom(best);
+                    best_cost = current_cost = shared_cost;
+                }
+            }
+        }
+
+        shared.offer(best.toPath(), best_cost);
+    }
+};
+
+#endif
@@ -0,0 +1,321 @@
+#ifndef CLARKE_WRIGHT_H
+#define CLARKE_WRIGHT_H
+
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <tuple>
+#include <utility>
+#include <map>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include "solution.h"
+#include "node.h"
+
+// Grafo do modelo do ex2 (heurísticas): arestas não dirigidas, carga da rota <= capacidade e arestas
+// ausentes com custo 0.
+class SymmetricNetwork {
+public:
+    int total_nodes;
+    std::vector<Node> nodes;
+    int total_edges;
+    std::map<int, std::vector<std::pair<int, int>>> adjacency_list;
+    std::vector<std::vector<int>> distance_matrix;
+
+    void loadFromFile(const std::string& graph_file) {
+        std::ifstream file(graph_file);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao abrir o arquivo" << std::endl;
+            return;
+        }
+
+        file >> total_nodes;
+        nodes.resize(total_nodes);
+        distance_matrix.resize(total_nodes, std::vector<int>(total_nodes, 0));
+
+        for (int i = 1; i < total_nodes; ++i) {
+            file >> nodes[i].id >> nodes[i].requirement;
+        }
+
+        file >> total_edges;
+        int from, to, weight;
+        for (int i = 0; i < total_edges; ++i) {
+            file >> from >> to >> weight;
+            adjacency_list[from].emplace_back(to, weight);
+            distance_matrix[from][to] = weight;
+            distance_matrix[to][from] = weight; // Assuming undirected graph
+        }
+
+        file.close();
+
+        std::cout << "Informações das Cidades:" << std::endl;
+        for (const auto& node : nodes) {
+            std::cout << "Cidade ID: " << node.id << " | Necessidade: " << node.requirement << std::endl;
+        }
+
+        std::cout << std::endl;
+
+        std::cout << "Mapa de Rotas:" << std::endl;
+        for (const auto& edge_list : adjacency_list) {
+            std::cout << "Origem " << edge_list.first << " -> ";
+            for (const auto& edge : edge_list.second) {
+                std::cout << "Destino " << edge.first << " (Custo: " << edge.second << ") ";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    int getRequirement(int node_id) const {
+        for (const auto& node : nodes) {
+            if (node.id == node_id) {
+                return node.requirement;
+            }
+        }
+        return 0;
+    }
+
+    void updateRequirement(int node_id, int new_requirement) {
+        for (auto& node : nodes) {
+            if (node.id == node_id) {
+                node.requirement = new_requirement;
+                return;
+            }
+        }
+    }
+
+    int totalRequirements() const {
+        int total = 0;
+        for (const auto& node : nodes) {
+            total += node.requirement;
+        }
+        return total;
+    }
+
+    int distance(int from, int to) const {
+        return distance_matrix[from][to];
+    }
+};
+
+// Clarke e Wright especializado em tempo de compilação para até MaxCustomers cidades: distâncias em
+// std::array com peso Weight, cada economia empacotada em um int64_t (economia, i, j) para ordenar sem
+// comparar tuplas e rotas em arrays de tamanho fixo. Nenhuma alocação no caminho inteiro.
+template <int MaxCustomers, typename Weight>
+class SmallClarkeWright {
+public:
+    static constexpr int MaxNodes = MaxCustomers + 1;
+    static constexpr int MaxSavings = MaxCustomers * (MaxCustomers - 1) / 2;
+
+    int total_nodes;
+    int max_capacity;
+    int max_visits;
+    std::array<std::array<Weight, MaxNodes>, MaxNodes> distance;
+    std::array<int64_t, MaxSavings> savings;
+    std::array<int, MaxNodes> next, route_id, head, tail, load, size;
+
+    static bool fits(const SymmetricNetwork& network) {
+        if (network.total_nodes > MaxNodes) {
+            return false;
+        }
+        for (int i = 0; i < network.total_nodes; ++i) {
+            for (int j = 0; j < network.total_nodes; ++j) {
+                int d = network.distance_matrix[i][j];
+                if (d < std::numeric_limits<Weight>::min() || d > std::numeric_limits<Weight>::max()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    SmallClarkeWright(const SymmetricNetwork& network, int cap, int visits) : total_nodes(network.total_nodes), max_capacity(cap), max_visits(visits) {
+        for (int i = 0; i < total_nodes; ++i) {
+            for (int j = 0; j < total_nodes; ++j) {
+                distance[i][j] = static_cast<Weight>(network.distance_matrix[i][j]);
+            }
+        }
+        for (int i = 1; i < total_nodes; ++i) {
+            next[i] = 0;
+            route_id[i] = head[i] = tail[i] = i;
+            load[i] = network.nodes[i].requirement;
+            size[i] = 1;
+        }
+    }
+
+    // Mesmo resultado do ClarkeWright genérico: ordem decrescente de (economia, i, j) e a rota j
+    // concatenada ao fim da rota i. Devolve as rotas em 'solution' com os mesmos identificadores.
+    template <typename Net>
+    void solve(Solution& solution, const Net& network) {
+        int count = 0;
+        for (int i = 1; i < total_nodes; ++i) {
+            for (int j = i + 1; j < total_nodes; ++j) {
+                int64_t s_ij = int64_t(distance[0][i]) + distance[0][j] - distance[i][j];
+                savings[count++] = s_ij * (int64_t(1) << 32) + (int64_t(i) << 16) + j;
+            }
+        }
+        std::sort(savings.begin(), savings.begin() + count, std::greater<int64_t>());
+
+        for (int k = 0; k < count; ++k) {
+            int i = static_cast<int>(savings[k] >> 16 & 0xFFFF);
+            int j = static_cast<int>(savings[k] & 0xFFFF);
+            int route_i = route_id[i];
+            int route_j = route_id[j];
+
+            bool merge = (route_i != route_j) & (load[route_i] + load[route_j] <= max_capacity) & (size[route_i] + size[route_j] + 2 <= max_visits);
+            if (merge) {
+                next[tail[route_i]] = head[route_j];
+                tail[route_i] = tail[route_j];
+                load[route_i] += load[route_j];
+                size[route_i] += size[route_j];
+                for (int node = head[route_j]; node != 0; node = next[node]) {
+                    route_id[node] = route_i;
+                }
+                size[route_j] = 0;
+            }
+        }
+
+        solution.clear();
+        for (int r = 1; r < total_nodes; ++r) {
+            for (int node = head[r]; size[r] > 0 && node != 0; node = next[node]) {
+                solution.append(r, node, network, network.nodes[node].requirement);
+            }
+        }
+    }
+};
+
+class ClarkeWright {
+public:
+    SymmetricNetwork network;
+    int max_capacity;
+    int max_visits;
+    Solution solution;
+
+    ClarkeWright(SymmetricNetwork net, int cap, int visits, IntArena& arena) : network(net), max_capacity(cap), max_visits(visits) {
+        solution.attach(arena, network.total_nodes);
+    }
+
+    template <int MaxCustomers, typename Weight>
+    bool solveSmall() {
+        if (!SmallClarkeWright<MaxCustomers, Weight>::fits(network)) {
+            return false;
+        }
+        SmallClarkeWright<MaxCustomers, Weight> kernel(network, max_capacity, max_visits);
+        kernel.solve(solution, network);
+        return true;
+    }
+
+    // Escolhe em tempo de execução a versão especializada que cabe na instância (até 64 cidades).
+    bool solveWithSmallKernel() {
+        if (network.total_nodes <= 17 && (solveSmall<16, int16_t>() || solveSmall<16, int>())) {
+            return true;
+        }
+        return network.total_nodes <= 65 && (solveSmall<64, int16_t>() || solveSmall<64, int>());
+    }
+
+    void solve() {
+        if (solveWithSmallKernel()) {
+            printSolution();
+            return;
+        }
+
+        std::vector<std::tuple<int, int, int>> savings;
+        for (int i = 1; i < network.total_nodes; ++i) {
+            for (int j = i + 1; j < network.total_nodes; ++j) {
+                int s_ij = network.distance_matrix[0][i] + network.distance_matrix[0][j] - network.distance_matrix[i][j];
+                savings.emplace_back(s_ij, i, j);
+            }
+        }
+
+        std::sort(savings.begin(), savings.end(), std::greater<std::tuple<int, int, int>>());
+
+        solution.startSingletons(network);
+
+        for (const auto& [saving, i, j] : savings) {
+            int route_i = solution.route_id[i];
+            int route_j = solution.route_id[j];
+
+            if (route_i != route_j && solution.load[route_i] + solution.load[route_j] <= max_capacity && solution.size[route_i] + solution.size[route_j] + 2 <= max_visits) {
+                solution.merge(route_i, route_j, network); // Liga o fim de route_i ao início de route_j
+            }
+        }
+
+        printSolution();
+    }
+
+private:
+    void printSolution() {
+        std::cout << "Rota a ser seguida:" << std::endl;
+        for (int r = 1; r < network.total_nodes; ++r) {
+            if (solution.size[r] > 0) { // Valid route
+                std::cout << "Rota: ";
+                for (int node : solution.routeNodes(r)) {
+                    std::cout << node << " ";
+                }
+                std::cout << "| Custo da rota: " << solution.cost[r] << std::endl;
+            }
+        }
+        std::cout << "Total de passos: " << network.total_nodes << std::endl;
+        std::cout << std::endl;
+
+        std::cout << "Detalhamento do custo:" << std::endl;
+        std::cout << "Custo total para percorrer a rota ótima: " << solution.totalCost() << std::endl;
+        std::cout << "Isso inclui os custos de viagem entre todas as cidades na rota." << std::endl;
+    }
+};
+
+// Clarke e Wright restrito a listas de candidatos: as economias só são calculadas entre cada cidade e
+// seus K vizinhos mais próximos (O(n·K) em vez de O(n²)) e as distâncias vêm de network.distance, sem
+// matriz. Só liga extremidades de rotas, invertendo uma delas quando preciso, o que supõe distâncias
+// simétricas (como as euclidianas das instâncias por coordenadas).
+template <typename Net>
+class CandidateClarkeWright {
+public:
+    const Net& network;
+    const std::vector<std::vector<int>>& neighbors;
+    int max_capacity;
+    int max_visits;
+    Solution solution;
+
+    CandidateClarkeWright(const Net& net, const std::vector<std::vector<int>>& near, int cap, int visits, IntArena& arena)
+        : network(net), neighbors(near), max_capacity(cap), max_visits(visits) {
+        solution.attach(arena, network.total_nodes);
+    }
+
+    void solve() {
+        std::vector<std::tuple<int, int, int>> savings;
+        for (int i = 1; i < network.total_nodes; ++i) {
+            for (int j : neighbors[i]) {
+                int a = std::min(i, j), b = std::max(i, j);
+                int s_ab = network.distance(0, a) + network.distance(0, b) - network.distance(a, b);
+                savings.emplace_back(s_ab, a, b);
+            }
+        }
+        // O par aparece duas vezes quando cada cidade está na lista da outra
+        std::sort(savings.begin(), savings.end(), std::greater<std::tuple<int, int, int>>());
+        savings.erase(std::unique(savings.begin(), savings.end()), savings.end());
+
+        solution.startSingletons(network);
+
+        for (const auto& [saving, i, j] : savings) {
+            int route_i = solution.route_id[i];
+            int route_j = solution.route_id[j];
+            if (route_i == route_j || !isEnd(route_i, i) || !isEnd(route_j, j)) {
+                continue;
+            }
+            if (solution.load[route_i] + solution.load[route_j] <= max_capacity && solution.size[route_i] + solution.size[route_j] + 2 <= max_visits) {
+                if (solution.tail[route_i] != i) solution.reverse(route_i, network);
+                if (solution.head[route_j] != j) solution.reverse(route_j, network);
+                solution.merge(route_i, route_j, network); // i passa a ser seguido diretamente por j
+            }
+        }
+    }
+
+private:
+    bool isEnd(int r, int node) const {
+        return solution.head[r] == node || solution.tail[r] == node;
+    }
+};
+
+#endif
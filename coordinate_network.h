@@ -0,0 +1,294 @@
+#ifndef COORDINATE_NETWORK_H
+#define COORDINATE_NETWORK_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <charconv>
+#include "clarke_wright.h"
+#include "solution_cache.h"
+
+// Instância definida por coordenadas: cada cidade guarda (x, y) e as distâncias são calculadas na hora,
+// arredondadas ao inteiro mais próximo como no EUC_2D do TSPLIB/CVRPLIB. A memória é O(n) em vez da
+// matriz O(n²), o que permite carregar instâncias com dezenas de milhares de clientes.
+class CoordinateNetwork {
+public:
+    std::string name;
+    int total_nodes = 0;
+    int capacity = 0;
+    std::vector<Node> nodes;
+    std::vector<double> x;
+    std::vector<double> y;
+
+    // Lê o formato CVRPLIB (NODE_COORD_SECTION, DEMAND_SECTION, DEPOT_SECTION). O depósito vira o nó 0 e
+    // os clientes são numerados de 1 em diante na ordem do arquivo; nodes[i].id guarda o id original.
+    bool loadFromFile(const std::string& instance_file) {
+        std::ifstream file(instance_file);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao abrir o arquivo" << std::endl;
+            return false;
+        }
+
+        int dimension = 0;
+        std::vector<double> file_x, file_y;
+        std::vector<int> file_demand;
+        std::vector<int> depots;
+        std::string line;
+        while (std::getline(file, line)) {
+            std::string key = line.substr(0, line.find(':'));
+            key.erase(std::remove_if(key.begin(), key.end(), ::isspace), key.end());
+            std::string value = line.find(':') == std::string::npos ? "" : line.substr(line.find(':') + 1);
+            value.erase(std::remove_if(value.begin(), value.end(), ::isspace), value.end());
+
+            bool section = key == "NODE_COORD_SECTION" || key == "DEMAND_SECTION" || key == "DEPOT_SECTION";
+            if (section && dimension < 1) {
+                std::cerr << "Seção " << key << " antes de DIMENSION" << std::endl;
+                return false;
+            }
+
+            if (key == "NAME") {
+                name = value;
+            } else if (key == "DIMENSION") {
+                if (!parsePositive(value, key, dimension)) {
+                    return false;
+                }
+                file_x.assign(dimension + 1, 0.0);
+                file_y.assign(dimension + 1, 0.0);
+                file_demand.assign(dimension + 1, 0);
+            } else if (key == "CAPACITY") {
+                if (!parsePositive(value, key, capacity)) {
+                    return false;
+                }
+            } else if (key == "EDGE_WEIGHT_TYPE" && value != "EUC_2D") {
+                std::cerr << "Tipo de distância não suportado: " << value << " (apenas EUC_2D)" << std::endl;
+                return false;
+            } else if (key == "NODE_COORD_SECTION") {
+                for (int k = 0; k < dimension; ++k) {
+                    int id;
+                    double cx, cy;
+                    file >> id >> cx >> cy;
+                    if (!validId(file, id, dimension, key)) {
+                        return false;
+                    }
+                    file_x[id] = cx;
+                    file_y[id] = cy;
+                }
+            } else if (key == "DEMAND_SECTION") {
+                for (int k = 0; k < dimension; ++k) {
+                    int id, d;
+                    file >> id >> d;
+                    if (!validId(file, id, dimension, key)) {
+                        return false;
+                    }
+                    file_demand[id] = d;
+                }
+            } else if (key == "DEPOT_SECTION") {
+                int id;
+                while (file >> id && id != -1) {
+                    if (!validId(file, id, dimension, key)) {
+                        return false;
+                    }
+                    depots.push_back(id);
+                }
+            }
+        }
+        file.close();
+
+        if (dimension < 1 || capacity <= 0) {
+            std::cerr << "Instância incompleta: DIMENSION e CAPACITY são obrigatórios" << std::endl;
+            return false;
+        }
+        int depot = depots.empty() ? 1 : depots[0];
+
+        total_nodes = dimension;
+        nodes.resize(total_nodes);
+        x.resize(total_nodes);
+        y.resize(total_nodes);
+        int index = 0;
+        place(index++, depot, file_x, file_y, 0);
+        for (int id = 1; id <= dimension; ++id) {
+            if (id != depot) {
+                place(index++, id, file_x, file_y, file_demand[id]);
+            }
+        }
+
+        std::cout << "Instância " << name << ": " << total_nodes - 1 << " clientes, capacidade " << capacity << std::endl;
+        std::cout << std::endl;
+        return true;
+    }
+
+    int distance(int from, int to) const {
+        double dx = x[from] - x[to];
+        double dy = y[from] - y[to];
+        return static_cast<int>(std::sqrt(dx * dx + dy * dy) + 0.5);
+    }
+
+private:
+    // Valor inteiro e positivo de um campo do cabeçalho (DIMENSION, CAPACITY); vazio, com texto ou fora
+    // do intervalo de int invalida a instância.
+    static bool parsePositive(const std::string& value, const std::string& key, int& result) {
+        int parsed = 0;
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (error != std::errc() || end != value.data() + value.size() || parsed < 1) {
+            std::cerr << key << " inválido: '" << value << "'" << std::endl;
+            return false;
+        }
+        result = parsed;
+        return true;
+    }
+
+    // Ids do arquivo vão de 1 a DIMENSION (o formato CVRPLIB não usa 0); qualquer outro valor, ou uma
+    // linha que não pôde ser lida, invalida a instância.
+    static bool validId(const std::ifstream& file, int id, int dimension, const std::string& section) {
+        if (!file || id < 1 || id > dimension) {
+            std::cerr << "Id inválido em " << section << ": esperado entre 1 e " << dimension << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void place(int index, int id, const std::vector<double>& file_x, const std::vector<double>& file_y, int demand) {
+        nodes[index].id = id;
+        nodes[index].requirement = demand;
+        x[index] = file_x[id];
+        y[index] = file_y[id];
+    }
+};
+
+// Hash da instância por coordenadas para o cache de resultados: capacidade, demandas e coordenadas na
+// numeração interna, em O(n) (a versão genérica percorreria as n² distâncias).
+inline uint64_t hashInstance(const CoordinateNetwork& network) {
+    InstanceHasher hasher;
+    hasher.add(static_cast<int64_t>(network.total_nodes));
+    hasher.add(static_cast<int64_t>(network.capacity));
+    for (int i = 0; i < network.total_nodes; ++i) {
+        hasher.add(static_cast<int64_t>(network.nodes[i].requirement));
+        hasher.add(network.x[i]);
+        hasher.add(network.y[i]);
+    }
+    return hasher.value;
+}
+
+// Demanda por índice interno (nodes[i].id guarda o id original do arquivo, não a posição).
+inline std::vector<int> demandById(const CoordinateNetwork& network) {
+    std::vector<int> demand(network.total_nodes, 0);
+    for (int i = 0; i < network.total_nodes; ++i) {
+        demand[i] = network.nodes[i].requirement;
+    }
+    return demand;
+}
+
+// Grade uniforme sobre os clientes (o depósito fica de fora), com cerca de dois clientes por célula e
+// as células guardadas de forma contígua (início de cada célula + lista de clientes). A busca dos K
+// vizinhos visita anéis de células cada vez mais distantes e para quando o anel seguinte já não pode
+// conter alguém mais próximo que o K-ésimo encontrado.
+class SpatialGrid {
+public:
+    const CoordinateNetwork& network;
+    double min_x = 0, min_y = 0;
+    double cell = 1;
+    int columns = 1, rows = 1;
+    std::vector<int> cell_start;
+    std::vector<int> members;
+
+    explicit SpatialGrid(const CoordinateNetwork& net) : network(net) {
+        int customers = network.total_nodes - 1;
+        if (customers < 1) {
+            cell_start.assign(2, 0);
+            return;
+        }
+        auto [lowest_x, highest_x] = std::minmax_element(network.x.begin() + 1, network.x.end());
+        auto [lowest_y, highest_y] = std::minmax_element(network.y.begin() + 1, network.y.end());
+        min_x = *lowest_x;
+        min_y = *lowest_y;
+        double width = std::max(*highest_x - min_x, 1e-9);
+        double height = std::max(*highest_y - min_y, 1e-9);
+        cell = std::max({std::sqrt(width * height * 2.0 / customers), std::max(width, height) * 2.0 / customers, 1e-9});
+        columns = std::max(1, static_cast<int>(width / cell) + 1);
+        rows = std::max(1, static_cast<int>(height / cell) + 1);
+
+        cell_start.assign(static_cast<size_t>(columns) * rows + 1, 0);
+        for (int i = 1; i < network.total_nodes; ++i) {
+            ++cell_start[cellOf(i) + 1];
+        }
+        for (size_t c = 1; c < cell_start.size(); ++c) {
+            cell_start[c] += cell_start[c - 1];
+        }
+        members.resize(customers);
+        std::vector<int> fill(cell_start.begin(), cell_start.end() - 1);
+        for (int i = 1; i < network.total_nodes; ++i) {
+            members[fill[cellOf(i)]++] = i;
+        }
+    }
+
+    // Os K clientes mais próximos de i (pela distância euclidiana exata; empates pelo menor id).
+    std::vector<int> nearest(int i, int k) const {
+        std::vector<std::pair<double, int>> found;
+        int cx = column(network.x[i]);
+        int cy = row(network.y[i]);
+        int max_ring = std::max(columns, rows);
+        for (int ring = 0; ring <= max_ring; ++ring) {
+            for (int gy = cy - ring; gy <= cy + ring; ++gy) {
+                if (gy < 0 || gy >= rows) continue;
+                bool edge_row = gy == cy - ring || gy == cy + ring;
+                for (int gx = cx - ring; gx <= cx + ring; gx += edge_row ? 1 : 2 * std::max(ring, 1)) {
+                    if (gx < 0 || gx >= columns) continue;
+                    int c = gy * columns + gx;
+                    for (int m = cell_start[c]; m < cell_start[c + 1]; ++m) {
+                        int j = members[m];
+                        if (j == i) continue;
+                        double dx = network.x[i] - network.x[j];
+                        double dy = network.y[i] - network.y[j];
+                        found.emplace_back(dx * dx + dy * dy, j);
+                    }
+                }
+            }
+            if (static_cast<int>(found.size()) >= k) {
+                std::nth_element(found.begin(), found.begin() + (k - 1), found.end());
+                double reach = ring * cell; // Distância mínima até qualquer célula fora dos anéis já vistos
+                if (found[k - 1].first < reach * reach) {
+                    break;
+                }
+            }
+        }
+
+        size_t keep = std::min<size_t>(k, found.size());
+        std::partial_sort(found.begin(), found.begin() + keep, found.end());
+        std::vector<int> result;
+        result.reserve(keep);
+        for (size_t t = 0; t < keep; ++t) {
+            result.push_back(found[t].second);
+        }
+        return result;
+    }
+
+private:
+    int column(double value) const {
+        return std::min(columns - 1, std::max(0, static_cast<int>((value - min_x) / cell)));
+    }
+
+    int row(double value) const {
+        return std::min(rows - 1, std::max(0, static_cast<int>((value - min_y) / cell)));
+    }
+
+    int cellOf(int i) const {
+        return row(network.y[i]) * columns + column(network.x[i]);
+    }
+};
+
+// Listas de candidatos pela grade: O(n·K) em média, em vez da varredura O(n²) da versão genérica.
+inline std::vector<std::vector<int>> nearestNeighbors(const CoordinateNetwork& network, int k) {
+    SpatialGrid grid(network);
+    std::vector<std::vector<int>> neighbors(network.total_nodes);
+    for (int i = 1; i < network.total_nodes; ++i) {
+        neighbors[i] = grid.nearest(i, k);
+    }
+    return neighbors;
+}
+
+#endif
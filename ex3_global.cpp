@@ -1,14 +1,19 @@
-# %%writefile mpic++ ex3_global.cpp -o ex3_global
+// Compilar com: mpic++ ex3_global.cpp -o ex3_global
 
 #include <iostream>
 #include <vector>
 #include <fstream>
 #include <tuple>
+#include <array>
 #include <utility>
 #include <map>
 #include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstdint>
 #include <mpi.h> 
 #include <chrono>
+#include "solution.h"
 
 const std::string graph = "grafo.txt";
 
@@ -22,47 +27,92 @@ bool existsInVector(const std::vector<int>& vec, int value) {
     return std::find(vec.begin(), vec.end(), value) != vec.end();
 }
 
+// A matriz de distâncias (total_nodes² inteiros) fica em uma janela de memória compartilhada do MPI-3,
+// uma por máquina: o rank 0 de cada máquina lê o arquivo e preenche a matriz, e os demais ranks da mesma
+// máquina só leem a partir do mesmo endereço físico. Assim a memória da matriz não é multiplicada pelo
+// número de processos por nó. Só a lista de cidades (O(n)) é copiada em cada processo.
 class Network {
 public:
     int total_nodes;
     std::vector<Node> nodes;
     int total_edges;
-    std::map<int, std::vector<std::pair<int, int>>> adjacency_list;
-    std::vector<std::vector<int>> distance_matrix;
+    std::map<int, std::vector<std::pair<int, int>>> adjacency_list; // Só no processo que imprime o mapa
+    const int* distance_matrix = nullptr; // Linha a linha: distance_matrix[from * total_nodes + to]
+
+    MPI_Comm node_comm = MPI_COMM_NULL;
+    MPI_Win window = MPI_WIN_NULL;
+
+    // Todos os processos chamam; 'verbose' indica o processo que imprime as cidades e o mapa.
+    void loadFromFile(const std::string& graph_file, bool verbose) {
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+        int node_rank;
+        MPI_Comm_rank(node_comm, &node_rank);
+
+        std::ifstream file;
+        total_nodes = 0;
+        if (node_rank == 0) {
+            file.open(graph_file);
+            if (!file.is_open()) {
+                std::cerr << "Erro ao abrir o arquivo" << std::endl;
+            } else {
+                file >> total_nodes;
+            }
+        }
+        MPI_Bcast(&total_nodes, 1, MPI_INT, 0, node_comm);
 
-    void loadFromFile(const std::string& graph_file) {
-        std::ifstream file(graph_file);
-        if (!file.is_open()) {
-            std::cerr << "Erro ao abrir o arquivo" << std::endl;
-            return;
+        // Cidades: lidas pelo rank 0 da máquina e repassadas aos demais
+        std::vector<int> node_data(2 * total_nodes, 0);
+        if (node_rank == 0) {
+            for (int i = 1; i < total_nodes; ++i) {
+                file >> node_data[2 * i] >> node_data[2 * i + 1];
+            }
         }
-        
-        file >> total_nodes;
+        MPI_Bcast(node_data.data(), static_cast<int>(node_data.size()), MPI_INT, 0, node_comm);
         nodes.resize(total_nodes);
-        distance_matrix.resize(total_nodes, std::vector<int>(total_nodes, 0));
-        
         for (int i = 1; i < total_nodes; ++i) {
-            file >> nodes[i].id >> nodes[i].requirement;
+            nodes[i].id = node_data[2 * i];
+            nodes[i].requirement = node_data[2 * i + 1];
+        }
+
+        // Só o rank 0 da máquina reserva a matriz; os outros pedem 0 bytes e consultam o endereço dele
+        MPI_Aint bytes = node_rank == 0 ? static_cast<MPI_Aint>(total_nodes) * total_nodes * sizeof(int) : 0;
+        int* base = nullptr;
+        MPI_Win_allocate_shared(bytes, sizeof(int), MPI_INFO_NULL, node_comm, &base, &window);
+        if (node_rank != 0) {
+            MPI_Aint size;
+            int disp_unit;
+            MPI_Win_shared_query(window, 0, &size, &disp_unit, &base);
         }
-        
-        file >> total_edges;
-        int from, to, weight;
-        for (int i = 0; i < total_edges; ++i) {
-            file >> from >> to >> weight;
-            adjacency_list[from].emplace_back(to, weight);
-            distance_matrix[from][to] = weight;
-            distance_matrix[to][from] = weight; 
+
+        MPI_Win_fence(0, window);
+        if (node_rank == 0 && total_nodes > 0) {
+            std::fill(base, base + static_cast<size_t>(total_nodes) * total_nodes, 0);
+            file >> total_edges;
+            int from, to, weight;
+            for (int i = 0; i < total_edges; ++i) {
+                file >> from >> to >> weight;
+                if (verbose) {
+                    adjacency_list[from].emplace_back(to, weight);
+                }
+                base[static_cast<size_t>(from) * total_nodes + to] = weight;
+                base[static_cast<size_t>(to) * total_nodes + from] = weight;
+            }
+            file.close();
+        }
+        MPI_Win_fence(0, window); // Escrita concluída e visível para toda a máquina
+        distance_matrix = base;
+
+        if (!verbose) {
+            return;
         }
 
-        file.close();
-        
         std::cout << "Informações das Cidades:" << std::endl;
         for (const auto& node : nodes) {
             std::cout << "Cidade ID: " << node.id << " | Necessidade: " << node.requirement << std::endl;
         }
 
         std::cout << std::endl;
-        
+
         std::cout << "Mapa de Rotas:" << std::endl;
         for (const auto& edge_list : adjacency_list) {
             std::cout << "Origem " << edge_list.first << " -> ";
@@ -74,6 +124,15 @@ public:
         std::cout << std::endl;
     }
 
+    // Libera a janela compartilhada (coletivo na máquina). As cópias do Network deixam de ser válidas.
+    void release() {
+        if (window != MPI_WIN_NULL) {
+            MPI_Win_free(&window);
+            MPI_Comm_free(&node_comm);
+        }
+        distance_matrix = nullptr;
+    }
+
     int getRequirement(int node_id) const {
         for (const auto& node : nodes) {
             if (node.id == node_id) {
@@ -99,6 +158,10 @@ public:
         }
         return total;
     }
+
+    int distance(int from, int to) const {
+        return distance_matrix[static_cast<size_t>(from) * total_nodes + to];
+    }
 };
 
 class ClarkeWright {
@@ -106,93 +169,102 @@ public:
     Network network;
     int max_capacity;
     int max_visits;
+    Solution solution;
 
-    ClarkeWright(Network net, int cap, int visits) : network(net), max_capacity(cap), max_visits(visits) {}
+    ClarkeWright(Network net, int cap, int visits, IntArena& arena) : network(net), max_capacity(cap), max_visits(visits) {
+        solution.attach(arena, network.total_nodes);
+    }
 
     void solve() {
         int rank, size;
         MPI_Comm_rank(MPI_COMM_WORLD, &rank); 
         MPI_Comm_size(MPI_COMM_WORLD, &size); 
 
-        std::vector<std::tuple<int, int, int>> savings;
-        for (int i = 1 + rank; i < network.total_nodes; i += size) { 
-            for (int j = i + 1; j < network.total_nodes; ++j) {
-                int s_ij = network.distance_matrix[0][i] + network.distance_matrix[0][j] - network.distance_matrix[i][j];
-                savings.emplace_back(s_ij, i, j);
+        // Quantas economias cada processo gera (a linha i tem n - 1 - i pares): todos sabem o tamanho de
+        // cada parte sem precisar trocar mensagens. As contagens e deslocamentos do MPI_Gatherv são int,
+        // então a lista inteira (3 inteiros por par) precisa caber em INT_MAX, cerca de 37 mil cidades
+        int n = network.total_nodes;
+        std::vector<int64_t> counts64(size, 0);
+        for (int i = 1; i < n; ++i) {
+            counts64[(i - 1) % size] += 3 * static_cast<int64_t>(n - 1 - i);
+        }
+        int64_t total64 = std::accumulate(counts64.begin(), counts64.end(), int64_t{0});
+        if (total64 > std::numeric_limits<int>::max()) {
+            if (rank == 0) {
+                std::cerr << "Instância grande demais para reunir as economias com MPI_Gatherv: " << total64
+                          << " inteiros (máximo " << std::numeric_limits<int>::max() << ")" << std::endl;
+            }
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        std::vector<int> counts(counts64.begin(), counts64.end()), displacements(size, 0);
+        for (int p = 1; p < size; ++p) {
+            displacements[p] = displacements[p - 1] + counts[p - 1];
+        }
+        int total = static_cast<int>(total64);
+
+        // Cada economia vai como três inteiros (economia, i, j). Só o processo 0 guarda a lista completa, e
+        // a parte dele é escrita direto no início do buffer de recepção (MPI_IN_PLACE); os demais guardam
+        // só a própria parte e a liberam logo depois do envio
+        std::vector<std::array<int, 3>> savings;
+        static_assert(sizeof(std::array<int, 3>) == 3 * sizeof(int), "economias precisam ser contíguas");
+        savings.reserve((rank == 0 ? total : counts[rank]) / 3);
+        for (int i = 1 + rank; i < n; i += size) {
+            for (int j = i + 1; j < n; ++j) {
+                int s_ij = network.distance(0, i) + network.distance(0, j) - network.distance(i, j);
+                savings.push_back({s_ij, i, j});
             }
         }
 
-        
-        std::vector<std::tuple<int, int, int>> combined_savings;
-        MPI_Allreduce(savings.data(), combined_savings.data(), savings.size(), MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        if (rank == 0) {
+            savings.resize(total / 3);
+            MPI_Gatherv(MPI_IN_PLACE, counts[0], MPI_INT, savings.data(), counts.data(), displacements.data(), MPI_INT, 0, MPI_COMM_WORLD);
+        } else {
+            MPI_Gatherv(savings.data(), counts[rank], MPI_INT, nullptr, nullptr, nullptr, MPI_INT, 0, MPI_COMM_WORLD);
+            std::vector<std::array<int, 3>>().swap(savings);
+            return; // Ordenação, junção das rotas e impressão ficam com o processo 0
+        }
 
-        std::sort(combined_savings.begin(), combined_savings.end(), [](const auto& a, const auto& b) { 
-            return std::get<0>(a) > std::get<0>(b);
+        std::sort(savings.begin(), savings.end(), [](const auto& a, const auto& b) { 
+            return a[0] > b[0];
         });
 
-        std::vector<std::vector<int>> routes(network.total_nodes);
-        std::vector<int> route_demands(network.total_nodes, 0);
-        #pragma omp parallel for schedule(dynamic) 
-        for (int i = 1; i < network.total_nodes; ++i) {
-            routes[i] = {0, i, 0};
-            route_demands[i] = network.nodes[i].requirement;
-        }
+        solution.startSingletons(network);
 
         #pragma omp parallel for schedule(dynamic) 
         for (size_t idx = 0; idx < savings.size(); ++idx) {
             const auto& [saving, i, j] = savings[idx];
-            int route_i = findRoute(routes, i);
-            int route_j = findRoute(routes, j);
+            #pragma omp critical
+            {
+                int route_i = solution.route_id[i];
+                int route_j = solution.route_id[j];
 
-            if (route_i != route_j && route_demands[route_i] + route_demands[route_j] <= max_capacity && routes[route_i].size() + routes[route_j].size() - 2 <= max_visits) {
-                mergeRoutes(routes, route_i, route_j, route_demands);
+                if (route_i != route_j && solution.load[route_i] + solution.load[route_j] <= max_capacity && solution.size[route_i] + solution.size[route_j] + 2 <= max_visits) {
+                    solution.merge(route_i, route_j, network);
+                }
             }
         }
 
-        printSolution(routes, route_demands);
+        printSolution();
 
     }
 
 private:
-    int findRoute(const std::vector<std::vector<int>>& routes, int node) {
-        for (int r = 1; r < routes.size(); ++r) {
-            if (std::find(routes[r].begin(), routes[r].end(), node) != routes[r].end()) {
-                return r;
-            }
-        }
-        return -1;
-    }
-
-    void mergeRoutes(std::vector<std::vector<int>>& routes, int route_i, int route_j, std::vector<int>& route_demands) {
-        routes[route_i].pop_back(); 
-        routes[route_i].insert(routes[route_i].end(), routes[route_j].begin() + 1, routes[route_j].end()); 
-        route_demands[route_i] += route_demands[route_j];
-        routes[route_j].clear(); 
-    }
-
-    void printSolution(const std::vector<std::vector<int>>& routes, const std::vector<int>& route_demands) {
-        int total_cost = 0;
+    void printSolution() {
         std::cout << "Rota a ser seguida:" << std::endl;
-        for (const auto& route : routes) {
-            if (route.size() > 2) { 
-                int route_cost = 0;
-                for (size_t i = 0; i < route.size() - 1; ++i) {
-                    route_cost += network.distance_matrix[route[i]][route[i + 1]];
-                }
-                total_cost += route_cost;
-
+        for (int r = 1; r < network.total_nodes; ++r) {
+            if (solution.size[r] > 0) { 
                 std::cout << "Rota: ";
-                for (int node : route) {
+                for (int node : solution.routeNodes(r)) {
                     std::cout << node << " ";
                 }
-                std::cout << "| Custo da rota: " << route_cost << std::endl;
+                std::cout << "| Custo da rota: " << solution.cost[r] << std::endl;
             }
         }
-        std::cout << "Total de passos: " << routes.size() << std::endl;
+        std::cout << "Total de passos: " << network.total_nodes << std::endl;
         std::cout << std::endl;
 
         std::cout << "Detalhamento do custo:" << std::endl;
-        std::cout << "Custo total para percorrer a rota ótima: " << total_cost << std::endl;
+        std::cout << "Custo total para percorrer a rota ótima: " << solution.totalCost() << std::endl;
         std::cout << "Isso inclui os custos de viagem entre todas as cidades na rota." << std::endl;
     }
 };
@@ -201,14 +273,19 @@ int main(int argc, char** argv) {
     MPI_Init(&argc, &argv); 
 
     std::vector<std::string> graph_files = {"grafos/grafo_03.txt", "grafos/grafo_05.txt", "grafos/grafo_07.txt", "grafos/grafo_09.txt", "grafos/grafo_11.txt"};
-    
+    IntArena arena; // Reaproveitada entre as instâncias
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
     for (const auto& file : graph_files) {
         Network network;
-        network.loadFromFile(file);
+        network.loadFromFile(file, rank == 0);
 
         auto start = std::chrono::high_resolution_clock::now();
 
-        ClarkeWright clarke_wright(network, 25, 10);
+        arena.reserve(Solution::footprint(network.total_nodes)); // Cresce só se a instância for maior
+        ClarkeWright clarke_wright(network, 25, 10, arena);
         clarke_wright.solve();
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -222,6 +299,8 @@ int main(int argc, char** argv) {
 
         output_file << "Tempo de execução de " << file <<": " << seconds << " segundos" << std::endl;
         output_file.close();
+
+        network.release();
     }
 
     MPI_Finalize(); 
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <omp.h> // Adicionando a biblioteca OpenMP
 #include <chrono>
+#include "solution.h"
 
 const std::string graph = "grafo.txt";
 
@@ -99,6 +100,10 @@ public:
         }
         return total;
     }
+
+    int distance(int from, int to) const {
+        return distance_matrix[from][to];
+    }
 };
 
 class ClarkeWright {
@@ -106,16 +111,24 @@ public:
     Network network;
     int max_capacity;
     int max_visits;
+    Solution solution;
 
-    ClarkeWright(Network net, int cap, int visits) : network(net), max_capacity(cap), max_visits(visits) {}
+    ClarkeWright(Network net, int cap, int visits, IntArena& arena) : network(net), max_capacity(cap), max_visits(visits) {
+        solution.attach(arena, network.total_nodes);
+    }
 
     void solve() {
-        std::vector<std::tuple<int, int, int>> savings;
+        // Cada par (i, j) tem posição fixa no vetor, reservado antes do laço: as threads escrevem em posições
+        // distintas, sem emplace_back concorrente. A linha i começa depois das linhas 1..i-1, cada uma com
+        // n - 1 - k pares
+        size_t n = network.total_nodes;
+        std::vector<std::tuple<int, int, int>> savings(n > 1 ? (n - 1) * (n - 2) / 2 : 0);
         #pragma omp parallel for schedule(dynamic) // Paralelizando o loop de geração de economias
         for (int i = 1; i < network.total_nodes; ++i) {
+            size_t row = (i - 1) * (n - 1) - static_cast<size_t>(i - 1) * i / 2;
             for (int j = i + 1; j < network.total_nodes; ++j) {
                 int s_ij = network.distance_matrix[0][i] + network.distance_matrix[0][j] - network.distance_matrix[i][j];
-                savings.emplace_back(s_ij, i, j);
+                savings[row + (j - i - 1)] = {s_ij, i, j};
             }
         }
 
@@ -123,68 +136,42 @@ public:
             return std::get<0>(a) > std::get<0>(b);
         });
 
-        std::vector<std::vector<int>> routes(network.total_nodes);
-        std::vector<int> route_demands(network.total_nodes, 0);
-        #pragma omp parallel for schedule(dynamic) // Paralelizando a inicialização das rotas
-        for (int i = 1; i < network.total_nodes; ++i) {
-            routes[i] = {0, i, 0};
-            route_demands[i] = network.nodes[i].requirement;
-        }
+        solution.startSingletons(network);
 
         #pragma omp parallel for schedule(dynamic) // Paralelizando o loop principal de mesclagem das rotas
         for (size_t idx = 0; idx < savings.size(); ++idx) {
             const auto& [saving, i, j] = savings[idx];
-            int route_i = findRoute(routes, i);
-            int route_j = findRoute(routes, j);
+            #pragma omp critical // As listas next/prev são compartilhadas: a verificação e a mescla precisam ser atômicas
+            {
+                int route_i = solution.route_id[i];
+                int route_j = solution.route_id[j];
 
-            if (route_i != route_j && route_demands[route_i] + route_demands[route_j] <= max_capacity && routes[route_i].size() + routes[route_j].size() - 2 <= max_visits) {
-                mergeRoutes(routes, route_i, route_j, route_demands);
+                if (route_i != route_j && solution.load[route_i] + solution.load[route_j] <= max_capacity && solution.size[route_i] + solution.size[route_j] + 2 <= max_visits) {
+                    solution.merge(route_i, route_j, network); // Liga o fim de rota_i ao início de rota_j
+                }
             }
         }
 
-        printSolution(routes, route_demands);
+        printSolution();
     }
 
 private:
-    int findRoute(const std::vector<std::vector<int>>& routes, int node) {
-        for (int r = 1; r < routes.size(); ++r) {
-            if (std::find(routes[r].begin(), routes[r].end(), node) != routes[r].end()) {
-                return r;
-            }
-        }
-        return -1;
-    }
-
-    void mergeRoutes(std::vector<std::vector<int>>& routes, int route_i, int route_j, std::vector<int>& route_demands) {
-        routes[route_i].pop_back(); // Remove o 0 final da rota_i
-        routes[route_i].insert(routes[route_i].end(), routes[route_j].begin() + 1, routes[route_j].end()); // Mescla rota_j em rota_i
-        route_demands[route_i] += route_demands[route_j];
-        routes[route_j].clear(); // Limpa rota_j, já que foi mesclada
-    }
-
-    void printSolution(const std::vector<std::vector<int>>& routes, const std::vector<int>& route_demands) {
-        int total_cost = 0;
+    void printSolution() {
         std::cout << "Rota a ser seguida:" << std::endl;
-        for (const auto& route : routes) {
-            if (route.size() > 2) { // Rota válida
-                int route_cost = 0;
-                for (size_t i = 0; i < route.size() - 1; ++i) {
-                    route_cost += network.distance_matrix[route[i]][route[i + 1]];
-                }
-                total_cost += route_cost;
-
+        for (int r = 1; r < network.total_nodes; ++r) {
+            if (solution.size[r] > 0) { // Rota válida
                 std::cout << "Rota: ";
-                for (int node : route) {
+                for (int node : solution.routeNodes(r)) {
                     std::cout << node << " ";
                 }
-                std::cout << "| Custo da rota: " << route_cost << std::endl;
+                std::cout << "| Custo da rota: " << solution.cost[r] << std::endl;
             }
         }
-        std::cout << "Total de passos: " << routes.size() << std::endl;
+        std::cout << "Total de passos: " << network.total_nodes << std::endl;
         std::cout << std::endl;
 
         std::cout << "Detalhamento do custo:" << std::endl;
-        std::cout << "Custo total para percorrer a rota ótima: " << total_cost << std::endl;
+        std::cout << "Custo total para percorrer a rota ótima: " << solution.totalCost() << std::endl;
         std::cout << "Isso inclui os custos de viagem entre todas as cidades na rota." << std::endl;
     }
 };
@@ -193,7 +180,9 @@ int main(int argc, char* argv[]) {
     Network network;
     network.loadFromFile(argv[1]);
 
-    ClarkeWright clarke_wright(network, 25, 10);
+    IntArena arena;
+    arena.reserve(Solution::footprint(network.total_nodes));
+    ClarkeWright clarke_wright(network, 25, 10, arena);
 
     // Iniciando a contagem de tempo
     auto start_time = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,343 @@
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <iomanip> // Para configurar a precisão ao escrever no arquivo
+#include <atomic>
+#include <thread>
+#include <random>
+#include <climits>
+#include "route_finder.h"
+#include "solution.h"
+#include "solution_cache.h"
+
+// Solução publicada por um dos resolvedores, no formato da busca exata: 0 c1 c2 0 c3 0 ...
+struct PublishedSolution {
+    int cost;
+    std::vector<int> route;
+    std::string solver;
+    PublishedSolution* next_allocated;
+};
+
+// Melhor solução compartilhada entre as threads sem uso de mutex: cada candidata é publicada
+// com compare-and-swap no ponteiro da melhor. As candidatas ficam numa pilha lock-free e só são
+// liberadas no destrutor, depois que todas as threads terminaram, então nenhuma leitura fica pendente.
+class BestSolutionSlot {
+public:
+    std::atomic<PublishedSolution*> best{nullptr};
+    std::atomic<int> best_cost{INT_MAX};
+    std::atomic<PublishedSolution*> allocated{nullptr};
+
+    ~BestSolutionSlot() {
+        PublishedSolution* node = allocated.load();
+        while (node != nullptr) {
+            PublishedSolution* next = node->next_allocated;
+            delete node;
+            node = next;
+        }
+    }
+
+    bool publish(const std::vector<int>& route, int cost, const std::string& solver) {
+        if (cost >= best_cost.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        auto* candidate = new PublishedSolution{cost, route, solver, allocated.load()};
+        while (!allocated.compare_exchange_weak(candidate->next_allocated, candidate)) {
+        }
+
+        PublishedSolution* current = best.load();
+        while (current == nullptr || cost < current->cost) {
+            if (best.compare_exchange_weak(current, candidate)) {
+                int known = best_cost.load();
+                while (cost < known && !best_cost.compare_exchange_weak(known, cost)) {
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const PublishedSolution* get() const {
+        return best.load();
+    }
+};
+
+// Modelo comum a todos os resolvedores do portfólio, o mesmo da busca exata (ex1): arestas dirigidas
+// da lista de adjacência, carga da rota estritamente menor que a capacidade e no máximo max_visits cidades.
+class HeuristicSolver {
+public:
+    const DirectedNetwork& network;
+    int max_capacity;
+    int max_visits;
+    std::vector<int> requirement_of;
+
+    HeuristicSolver(const DirectedNetwork& net, int cap, int visits) : network(net), max_capacity(cap), max_visits(visits) {
+        requirement_of.assign(network.total_nodes, 0);
+        for (const auto& node : network.nodes) {
+            requirement_of[node.id] = node.requirement;
+        }
+    }
+
+    bool fits(const Solution& solution, int r, int node) const {
+        return solution.load[r] + requirement_of[node] < max_capacity && solution.size[r] + 1 <= max_visits;
+    }
+
+    bool isFeasible(const Solution& solution) const {
+        return solution.totalCost() < DirectedNetwork::NO_EDGE;
+    }
+
+    // Clarke e Wright para arestas dirigidas: a economia s_ij = d(i,0) + d(0,j) - d(i,j) liga
+    // o fim da rota de i ao início da rota de j.
+    void clarkeWright(Solution& solution) const {
+        std::vector<std::tuple<int, int, int>> savings;
+        for (const auto& edge_list : network.adjacency_list) {
+            int i = edge_list.first;
+            for (const auto& edge : edge_list.second) {
+                int j = edge.first;
+                if (i != 0 && j != 0 && requirement_of[i] != 0 && requirement_of[j] != 0) {
+                    savings.emplace_back(network.distance(i, 0) + network.distance(0, j) - edge.second, i, j);
+                }
+            }
+        }
+        std::sort(savings.begin(), savings.end(), std::greater<std::tuple<int, int, int>>());
+
+        solution.clear();
+        for (int i = 1; i < network.total_nodes; ++i) {
+            if (requirement_of[i] != 0) {
+                solution.append(i, i, network, requirement_of[i]);
+            }
+        }
+
+        for (const auto& [saving, i, j] : savings) {
+            int route_i = solution.route_id[i];
+            int route_j = solution.route_id[j];
+            if (route_i != route_j && solution.tail[route_i] == i && solution.head[route_j] == j &&
+                solution.load[route_i] + solution.load[route_j] < max_capacity &&
+                solution.size[route_i] + solution.size[route_j] <= max_visits) {
+                solution.merge(route_i, route_j, network);
+            }
+        }
+    }
+
+    // Melhor posição viável para o cliente entre todas as rotas (ou uma rota nova). Retorna o acréscimo de custo.
+    int bestInsertion(const Solution& solution, int node, int& best_route, int& best_after) const {
+        int best_delta = INT_MAX;
+        best_route = -1;
+        bool tried_empty = false;
+        for (int r = 1; r < solution.total_nodes; ++r) {
+            if (solution.size[r] == 0) {
+                if (tried_empty) continue;
+                tried_empty = true;
+            }
+            if (!fits(solution, r, node)) {
+                continue;
+            }
+            int after = 0;
+            do {
+                int delta = solution.insertionDelta(r, after, node, network);
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_route = r;
+                    best_after = after;
+                }
+                after = after == 0 ? solution.head[r] : solution.next[after];
+            } while (solution.size[r] > 0 && after != 0);
+        }
+        return best_delta;
+    }
+
+    // Busca local de realocação: move cada cliente para a melhor posição enquanto houver melhora.
+    void relocate(Solution& solution, const std::atomic<bool>& cancel) const {
+        bool improved = true;
+        while (improved && !cancel.load(std::memory_order_relaxed)) {
+            improved = false;
+            for (int node = 1; node < network.total_nodes; ++node) {
+                int r = solution.route_id[node];
+                if (r == 0) {
+                    continue;
+                }
+                int before = solution.cost[r];
+                int after = solution.prev[node];
+                solution.remove(node, network, requirement_of[node]);
+                int removal_gain = before - solution.cost[r];
+
+                int best_route, best_after;
+                int delta = bestInsertion(solution, node, best_route, best_after);
+                if (best_route != -1 && delta < removal_gain) {
+                    solution.insertAfter(best_route, best_after, node, network, requirement_of[node]);
+                    improved = true;
+                } else {
+                    solution.insertAfter(r, after, node, network, requirement_of[node]);
+                }
+            }
+        }
+    }
+
+    // Perturbação: retira alguns clientes ao acaso e os reinsere na melhor posição viável.
+    bool perturb(Solution& solution, std::mt19937& rng, int count) const {
+        std::vector<int> customers;
+        for (int node = 1; node < network.total_nodes; ++node) {
+            if (solution.route_id[node] != 0) customers.push_back(node);
+        }
+        std::shuffle(customers.begin(), customers.end(), rng);
+        customers.resize(std::min<size_t>(count, customers.size()));
+
+        for (int node : customers) {
+            solution.remove(node, network, requirement_of[node]);
+        }
+        for (int node : customers) {
+            int best_route, best_after;
+            bestInsertion(solution, node, best_route, best_after);
+            if (best_route == -1) {
+                return false;
+            }
+            solution.insertAfter(best_route, best_after, node, network, requirement_of[node]);
+        }
+        return true;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    DirectedNetwork network;
+    network.loadFromFile(argv[1]);
+
+    // Prazo total do portfólio em segundos
+    double deadline = argc > 2 ? std::stod(argv[2]) : 10.0;
+    int max_capacity = 25, max_visits = 10;
+
+    BestSolutionSlot slot;
+    std::atomic<bool> cancel{false};
+    std::atomic<bool> proven_optimal{false};
+    bool optimal_from_cache = false; // Ótimo já comprovado em uma execução anterior: nenhuma busca roda
+
+    // Resultado anterior (mesmo modelo da busca exata do ex1): um ótimo comprovado dispensa os
+    // resolvedores; uma solução não comprovada entra na vaga como limite e ponto de partida
+    SolutionCache cache;
+    std::string cache_key = cache.key(hashInstance(network), "exato", max_capacity, max_visits);
+    CachedResult cached;
+    if (cache.loadValid(cache_key, network, max_capacity - 1, max_visits, cached)) { // Carga < capacidade, como no ex1
+        slot.publish(cached.path, cached.cost, "cache");
+        proven_optimal = cached.optimal;
+        optimal_from_cache = cached.optimal;
+    }
+
+    // Iniciando a contagem de tempo
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    if (!proven_optimal) {
+        // Busca exata: usa a melhor solução do portfólio como limite e, ao terminar, prova a otimalidade
+        std::thread exact([&]() {
+            RouteFinder route_finder(network, max_capacity, max_visits);
+            route_finder.external_bound = &slot.best_cost;
+            route_finder.cancel = &cancel;
+            route_finder.on_improvement = [&](const std::vector<int>& route, int cost) {
+                slot.publish(route, cost, "busca exata");
+            };
+            route_finder.frontier.push_back(SearchState{0, 0, max_capacity, 0, {0}});
+            if (route_finder.run(0)) {
+                proven_optimal = true;
+                cancel = true;
+            }
+        });
+
+        // Clarke e Wright seguido de busca local iterada (perturbação + realocação) até o cancelamento
+        std::thread heuristic([&]() {
+            HeuristicSolver solver(network, max_capacity, max_visits);
+            IntArena arena;
+            arena.reserve(2 * Solution::footprint(network.total_nodes));
+            Solution current, candidate;
+            current.attach(arena, network.total_nodes);
+            candidate.attach(arena, network.total_nodes);
+
+            solver.clarkeWright(current);
+            if (solver.isFeasible(current)) {
+                slot.publish(current.toPath(), current.totalCost(), "Clarke e Wright");
+            }
+
+            solver.relocate(current, cancel);
+            if (solver.isFeasible(current)) {
+                slot.publish(current.toPath(), current.totalCost(), "Clarke e Wright + realocação");
+            }
+
+            std::mt19937 rng(12345);
+            int perturbation = std::max(2, network.total_nodes / 10);
+            while (!cancel.load(std::memory_order_relaxed)) {
+                const PublishedSolution* best = slot.get();
+                if (best != nullptr && best->cost < current.totalCost()) {
+                    current.fromPath(best->route, network, solver.requirement_of); // Continua a partir da melhor solução de qualquer resolvedor
+                }
+
+                candidate.copyFrom(current);
+                if (!solver.perturb(candidate, rng, perturbation)) {
+                    continue;
+                }
+                solver.relocate(candidate, cancel);
+
+                if (candidate.totalCost() <= current.totalCost()) {
+                    current.copyFrom(candidate);
+                    if (solver.isFeasible(current)) {
+                        slot.publish(current.toPath(), current.totalCost(), "busca local iterada");
+                    }
+                }
+            }
+        });
+
+        while (!cancel.load()) {
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start_time;
+            if (elapsed.count() >= deadline) {
+                cancel = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        exact.join();
+        heuristic.join();
+    }
+
+    // Finalizando a contagem de tempo
+    auto end_time = std::chrono::high_resolution_clock::now();
+
+    const PublishedSolution* best = slot.get();
+    if (best != nullptr) {
+        cache.store(cache_key, best->solver, best->cost, proven_optimal, best->route);
+    }
+    if (best == nullptr) {
+        std::cout << "Nenhuma solução viável encontrada dentro do prazo." << std::endl;
+    } else {
+        std::cout << "Rota a ser seguida:" << std::endl;
+        for (size_t i = 0; i < best->route.size(); ++i) {
+            std::cout << "Passo " << i + 1 << ": Cidade " << best->route[i] << std::endl;
+        }
+        std::cout << "Total de passos: " << best->route.size() << std::endl;
+        std::cout << std::endl;
+
+        std::cout << "Detalhamento do custo:" << std::endl;
+        std::cout << "Custo total da melhor rota encontrada: " << best->cost << std::endl;
+        std::cout << "Encontrada por: " << best->solver << std::endl;
+        if (optimal_from_cache) {
+            std::cout << "Ótimo comprovado recuperado do cache (" << cache.pathOf(cache_key) << ")" << std::endl;
+        } else {
+            std::cout << (proven_optimal ? "Otimalidade comprovada pela busca exata." : "Prazo atingido: otimalidade não comprovada.") << std::endl;
+        }
+    }
+
+    // Calculando o tempo decorrido em segundos com precisão
+    std::chrono::duration<double> duration = end_time - start_time;
+    double execution_time = duration.count();
+
+    // Salvando o tempo de execução em um arquivo de texto
+    std::ofstream time_file("ex4_time.txt", std::ios_base::app); // Abre o arquivo em modo de apêndice
+    if (time_file.is_open()) {
+        time_file << std::fixed << std::setprecision(6) << "Tempo de execução: " << execution_time << " segundos" << std::endl;
+        time_file.close();
+        std::cout << "Tempo de execução de " << execution_time << " salvo em 'ex4_time.txt'" << std::endl;
+    } else {
+        std::cerr << "Erro ao abrir o arquivo para salvar o tempo de execução." << std::endl;
+    }
+
+    return 0;
+}
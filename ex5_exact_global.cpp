@@ -0,0 +1,394 @@
+// Compilação: mpic++ -O2 ex5_exact_global.cpp -o ex5_exact_global
+// Execução:   mpirun -np 4 ./ex5_exact_global grafos/grafo_11.txt [limite_segundos]
+
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <iomanip> // Para configurar a precisão ao escrever no arquivo
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mpi.h>
+#include "route_finder.h"
+#include "solution_cache.h"
+
+// Mensagens trocadas entre o gerente (rank 0) e os trabalhadores
+enum Tag {
+    TAG_REQUEST = 1,   // trabalhador -> gerente: ficou sem trabalho
+    TAG_WORK,          // gerente -> trabalhador: subproblemas para explorar
+    TAG_STEAL,         // gerente -> trabalhador: devolva metade da sua fronteira
+    TAG_DONATION,      // trabalhador -> gerente: subproblemas doados (pode ser vazio)
+    TAG_INCUMBENT,     // trabalhador -> gerente: nova melhor solução (custo + rota)
+    TAG_BOUND,         // gerente -> trabalhador: custo da melhor solução global
+    TAG_DONE,          // gerente -> trabalhador: encerrar
+    TAG_STOPPED        // trabalhador -> gerente: última mensagem, com a contagem de estados explorados
+};
+
+// Fatia de tempo que o trabalhador explora antes de atender mensagens
+const double WORKER_SLICE = 0.01;
+
+// Depois de uma doação vazia, o gerente espera este tempo (cinco fatias) antes de pedir de novo ao mesmo
+// trabalhador
+const std::chrono::milliseconds STEAL_BACKOFF(50);
+
+// Serialização de subproblemas: [quantidade, (custo, nó, capacidade, visitas, tamanho, caminho...)...]
+std::vector<int> packStates(const std::vector<SearchState>& states, size_t begin, size_t end) {
+    std::vector<int> buffer = {static_cast<int>(end - begin)};
+    for (size_t i = begin; i < end; ++i) {
+        const auto& state = states[i];
+        buffer.insert(buffer.end(), {state.cost, state.current_node, state.remaining_capacity, state.visited_count,
+                                     static_cast<int>(state.visited_nodes.size())});
+        buffer.insert(buffer.end(), state.visited_nodes.begin(), state.visited_nodes.end());
+    }
+    return buffer;
+}
+
+void unpackStates(const std::vector<int>& buffer, std::vector<SearchState>& states) {
+    size_t pos = 1;
+    for (int k = 0; k < buffer[0]; ++k) {
+        SearchState state{buffer[pos], buffer[pos + 1], buffer[pos + 2], buffer[pos + 3], {}};
+        int length = buffer[pos + 4];
+        pos += 5;
+        state.visited_nodes.assign(buffer.begin() + pos, buffer.begin() + pos + length);
+        pos += length;
+        states.push_back(std::move(state));
+    }
+}
+
+// Recebe a próxima mensagem de 'source' (ou de qualquer rank), de qualquer tag e tamanho.
+std::vector<int> receive(int source, MPI_Status& status) {
+    MPI_Probe(source, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+    int count;
+    MPI_Get_count(&status, MPI_INT, &count);
+    std::vector<int> buffer(std::max(count, 1));
+    MPI_Recv(buffer.data(), count, MPI_INT, status.MPI_SOURCE, status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    buffer.resize(count);
+    return buffer;
+}
+
+// Gerente: guarda o conjunto de subproblemas pendentes e a incumbente global, entrega trabalho a quem
+// pede, rouba metade da fronteira de um trabalhador ocupado sorteado quando o conjunto esvazia e
+// repassa cada melhora do limite a todos os trabalhadores com envios não bloqueantes. Os envios concluídos
+// são liberados a cada volta do laço, e um trabalhador que acabou de doar nada não é escolhido de novo
+// antes de STEAL_BACKOFF.
+class Manager {
+public:
+    int workers;
+    double time_limit;
+    std::vector<SearchState> pool;
+    std::vector<int> optimal_route;
+    int minimal_cost = 999999;
+    long long explored = 0;
+    bool interrupted = false;
+
+    std::vector<bool> idle;
+    std::vector<bool> steal_pending;
+    std::vector<std::chrono::steady_clock::time_point> steal_after; // Quando cada trabalhador pode ser roubado
+    std::vector<MPI_Request> requests;
+    std::vector<std::unique_ptr<std::vector<int>>> send_buffers; // Mantidos vivos até o envio terminar
+    std::mt19937 rng{2024};
+
+    Manager(int size, double limit)
+        : workers(size - 1), time_limit(limit), idle(size, false), steal_pending(size, false), steal_after(size) {}
+
+    void post(int dest, int tag, std::vector<int> data) {
+        send_buffers.push_back(std::make_unique<std::vector<int>>(std::move(data)));
+        requests.emplace_back();
+        auto& buffer = *send_buffers.back();
+        MPI_Isend(buffer.data(), static_cast<int>(buffer.size()), MPI_INT, dest, tag, MPI_COMM_WORLD, &requests.back());
+    }
+
+    // Libera os envios já concluídos e seus buffers.
+    void reap() {
+        if (requests.empty()) {
+            return;
+        }
+        int completed;
+        std::vector<int> indices(requests.size());
+        MPI_Testsome(static_cast<int>(requests.size()), requests.data(), &completed, indices.data(), MPI_STATUSES_IGNORE);
+        if (completed == MPI_UNDEFINED || completed == 0) {
+            return;
+        }
+        size_t kept = 0;
+        for (size_t k = 0; k < requests.size(); ++k) {
+            if (requests[k] != MPI_REQUEST_NULL) {
+                requests[kept] = requests[k];
+                send_buffers[kept] = std::move(send_buffers[k]);
+                ++kept;
+            }
+        }
+        requests.resize(kept);
+        send_buffers.resize(kept);
+    }
+
+    void run(int max_capacity) {
+        pool.push_back(SearchState{0, 0, max_capacity, 0, {0}});
+        auto start = std::chrono::steady_clock::now();
+        int stopped = 0;
+        bool stopping = false;
+
+        while (stopped < workers) {
+            MPI_Status status;
+            int flag = 1;
+            if (!stopping && time_limit > 0) {
+                MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+            }
+
+            if (flag) {
+                std::vector<int> message = receive(MPI_ANY_SOURCE, status);
+                int source = status.MPI_SOURCE;
+
+                if (status.MPI_TAG == TAG_REQUEST) {
+                    idle[source] = true;
+                } else if (status.MPI_TAG == TAG_DONATION) {
+                    if (message[0] == 0) {
+                        steal_after[source] = std::chrono::steady_clock::now() + STEAL_BACKOFF;
+                    }
+                    unpackStates(message, pool);
+                    steal_pending[source] = false;
+                } else if (status.MPI_TAG == TAG_INCUMBENT) {
+                    if (message[0] < minimal_cost) {
+                        minimal_cost = message[0];
+                        optimal_route.assign(message.begin() + 1, message.end());
+                        for (int w = 1; w <= workers && !stopping; ++w) {
+                            if (w != source) post(w, TAG_BOUND, {minimal_cost});
+                        }
+                    }
+                } else if (status.MPI_TAG == TAG_STOPPED) {
+                    explored += static_cast<long long>(message[0]) << 31 | message[1];
+                    ++stopped;
+                }
+            }
+
+            reap();
+            if (stopping) {
+                continue;
+            }
+            if (!flag) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (time_limit > 0 && elapsed.count() >= time_limit) {
+                interrupted = true;
+                stopping = true;
+                for (int w = 1; w <= workers; ++w) post(w, TAG_DONE, {0});
+                continue;
+            }
+
+            dispatch();
+
+            bool all_idle = std::all_of(idle.begin() + 1, idle.end(), [](bool v) { return v; });
+            bool no_steal = std::none_of(steal_pending.begin(), steal_pending.end(), [](bool v) { return v; });
+            if (pool.empty() && all_idle && no_steal) {
+                stopping = true;
+                for (int w = 1; w <= workers; ++w) post(w, TAG_DONE, {0});
+            }
+        }
+
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    // Entrega subproblemas aos ociosos; sem subproblemas, pede a um ocupado que doe parte dos seus.
+    void dispatch() {
+        for (int w = 1; w <= workers && !pool.empty(); ++w) {
+            if (idle[w]) {
+                size_t share = std::max<size_t>(1, pool.size() / workers);
+                size_t begin = pool.size() - std::min(share, pool.size());
+                std::vector<int> data = packStates(pool, begin, pool.size());
+                data.push_back(minimal_cost); // O limite atual segue junto com o trabalho
+                post(w, TAG_WORK, std::move(data));
+                pool.resize(begin);
+                idle[w] = false;
+                steal_after[w] = {}; // Com trabalho novo, volta a poder ser roubado
+            }
+        }
+
+        bool someone_idle = std::any_of(idle.begin() + 1, idle.end(), [](bool v) { return v; });
+        bool stealing = std::any_of(steal_pending.begin(), steal_pending.end(), [](bool v) { return v; });
+        if (pool.empty() && someone_idle && !stealing) {
+            std::vector<int> busy;
+            auto now = std::chrono::steady_clock::now();
+            for (int w = 1; w <= workers; ++w) {
+                if (!idle[w] && now >= steal_after[w]) busy.push_back(w);
+            }
+            if (!busy.empty()) {
+                int victim = busy[std::uniform_int_distribution<size_t>(0, busy.size() - 1)(rng)];
+                post(victim, TAG_STEAL, {0});
+                steal_pending[victim] = true;
+            }
+        }
+    }
+};
+
+// Trabalhador: explora os subproblemas recebidos com a busca do ex1 em fatias de tempo curtas,
+// atendendo entre as fatias as atualizações de limite e os pedidos de doação do gerente.
+class Worker {
+public:
+    RouteFinder route_finder;
+    std::atomic<int> global_bound{999999};
+
+    Worker(const DirectedNetwork& network, int cap, int visits) : route_finder(network, cap, visits) {
+        route_finder.external_bound = &global_bound;
+        route_finder.on_improvement = [this](const std::vector<int>& route, int cost) {
+            std::vector<int> data = {cost};
+            data.insert(data.end(), route.begin(), route.end());
+            MPI_Send(data.data(), static_cast<int>(data.size()), MPI_INT, 0, TAG_INCUMBENT, MPI_COMM_WORLD);
+            lowerBound(cost);
+        };
+    }
+
+    void lowerBound(int cost) {
+        if (cost < global_bound.load()) {
+            global_bound = cost;
+        }
+    }
+
+    // Trata uma mensagem do gerente. Retorna false ao receber TAG_DONE.
+    bool handle(const std::vector<int>& message, int tag) {
+        auto& frontier = route_finder.frontier;
+        if (tag == TAG_WORK) {
+            unpackStates(message, frontier);
+            lowerBound(message.back());
+        } else if (tag == TAG_BOUND) {
+            lowerBound(message[0]);
+        } else if (tag == TAG_STEAL) {
+            // Doa a metade mais antiga da pilha: estados rasos, com as maiores subárvores
+            size_t half = frontier.size() / 2;
+            std::vector<int> data = packStates(frontier, 0, half);
+            frontier.erase(frontier.begin(), frontier.begin() + half);
+            MPI_Send(data.data(), static_cast<int>(data.size()), MPI_INT, 0, TAG_DONATION, MPI_COMM_WORLD);
+        } else if (tag == TAG_DONE) {
+            return false;
+        }
+        return true;
+    }
+
+    void run() {
+        MPI_Status status;
+        bool running = true;
+        bool requested = false;
+
+        while (running) {
+            if (route_finder.frontier.empty()) {
+                if (!requested) {
+                    int none = 0;
+                    MPI_Send(&none, 1, MPI_INT, 0, TAG_REQUEST, MPI_COMM_WORLD);
+                    requested = true;
+                }
+                std::vector<int> message = receive(0, status);
+                running = handle(message, status.MPI_TAG);
+                if (status.MPI_TAG == TAG_WORK) {
+                    requested = false;
+                }
+                continue;
+            }
+
+            route_finder.run(WORKER_SLICE);
+
+            int flag = 1;
+            while (running && flag) {
+                MPI_Iprobe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+                if (flag) {
+                    std::vector<int> message = receive(0, status);
+                    running = handle(message, status.MPI_TAG);
+                }
+            }
+        }
+
+        long long explored = route_finder.explored;
+        int counts[2] = {static_cast<int>(explored >> 31), static_cast<int>(explored & 0x7FFFFFFF)};
+        MPI_Send(counts, 2, MPI_INT, 0, TAG_STOPPED, MPI_COMM_WORLD);
+    }
+};
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    if (argc < 2 || size < 2) {
+        if (rank == 0) {
+            std::cerr << "Uso: mpirun -np N ./ex5_exact_global <grafo> [limite_segundos] (N >= 2)" << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    DirectedNetwork network;
+    network.loadFromFile(argv[1], rank == 0);
+    double time_limit = argc > 2 ? std::stod(argv[2]) : 0.0;
+    int max_capacity = 25, max_visits = 10;
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // O gerente consulta o cache (mesma chave do ex1): com um ótimo já comprovado ninguém busca;
+    // com uma solução não comprovada ela vira a incumbente inicial, repassada junto com o trabalho
+    SolutionCache cache;
+    std::string cache_key;
+    CachedResult cached;
+    int cached_optimal = 0;
+    if (rank == 0) {
+        cache_key = cache.key(hashInstance(network), "exato", max_capacity, max_visits);
+        if (cache.loadValid(cache_key, network, max_capacity - 1, max_visits, cached)) { // Carga < capacidade, como no ex1
+            cached_optimal = cached.optimal ? 1 : 0;
+        } else {
+            cached.path.clear();
+        }
+    }
+    MPI_Bcast(&cached_optimal, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        Manager manager(size, time_limit);
+        if (!cached.path.empty()) {
+            manager.optimal_route = cached.path;
+            manager.minimal_cost = cached.cost;
+        }
+        if (cached_optimal) {
+            std::cout << "Ótimo comprovado recuperado do cache (chave " << cache_key << ")" << std::endl << std::endl;
+        } else {
+            manager.run(max_capacity);
+            cache.store(cache_key, "exato distribuído", manager.minimal_cost, !manager.interrupted, manager.optimal_route);
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = end_time - start_time;
+        double execution_time = duration.count();
+
+        if (manager.interrupted) {
+            std::cout << "Limite de tempo atingido: busca interrompida (solução não comprovadamente ótima)" << std::endl;
+        }
+        std::cout << "Rota a ser seguida:" << std::endl;
+        for (size_t i = 0; i < manager.optimal_route.size(); ++i) {
+            std::cout << "Passo " << i + 1 << ": Cidade " << manager.optimal_route[i] << std::endl;
+        }
+        std::cout << "Total de passos: " << manager.optimal_route.size() << std::endl;
+        std::cout << std::endl;
+
+        std::cout << "Detalhamento do custo:" << std::endl;
+        std::cout << "Custo total para percorrer a rota ótima: " << manager.minimal_cost << std::endl;
+        std::cout << "Estados explorados por " << size - 1 << " trabalhadores: " << manager.explored << std::endl;
+
+        std::ofstream time_file("ex5_time.txt", std::ios_base::app);
+        if (time_file.is_open()) {
+            time_file << std::fixed << std::setprecision(6) << "Tempo de execução de " << argv[1] << " com " << size
+                      << " processos: " << execution_time << " segundos" << std::endl;
+            time_file.close();
+            std::cout << "Tempo de execução de " << execution_time << " salvo em 'ex5_time.txt'" << std::endl;
+        } else {
+            std::cerr << "Erro ao abrir o arquivo para salvar o tempo de execução." << std::endl;
+        }
+    } else if (!cached_optimal) {
+        Worker worker(network, max_capacity, max_visits);
+        worker.run();
+    }
+
+    MPI_Finalize();
+
+    return 0;
+}
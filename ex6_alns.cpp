@@ -0,0 +1,103 @@
+#include <iostream>
+#include <vector>
+#include <iomanip> // Para configurar a precisão ao escrever no arquivo
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include "clarke_wright.h"
+#include "alns.h"
+#include "solution_cache.h"
+
+int main(int argc, char* argv[]) {
+    SymmetricNetwork network;
+    network.loadFromFile(argv[1]);
+
+    // Parâmetros opcionais: prazo da melhoria em segundos e número de threads
+    double time_limit = argc > 2 ? std::stod(argv[2]) : 10.0;
+    unsigned threads = argc > 3 ? std::stoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    int max_capacity = 25, max_visits = 10;
+
+    // Iniciando a contagem de tempo
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Solução inicial: Clarke e Wright
+    // Uma arena para as três soluções do programa: Clarke e Wright, ponto de partida e melhor
+    IntArena arena;
+    arena.reserve(3 * Solution::footprint(network.total_nodes));
+    ClarkeWright clarke_wright(network, max_capacity, max_visits, arena);
+    clarke_wright.solve();
+    int initial_cost = clarke_wright.solution.totalCost();
+
+    // Ponto de partida: a melhor solução guardada no cache para esta instância, se for melhor que o C&W
+    Solution start;
+    start.attach(arena, network.total_nodes);
+    start.copyFrom(clarke_wright.solution);
+    SolutionCache cache;
+    std::string cache_key = cache.key(hashInstance(network), "alns", max_capacity, max_visits);
+    CachedResult cached;
+    // Modelo do ex2: carga <= capacidade e rota + 2 visitas ao depósito <= max_visits
+    if (cache.loadValid(cache_key, network, max_capacity, max_visits - 2, cached) && cached.cost < initial_cost) {
+        start.fromPath(cached.path, network);
+        std::cout << "Partindo da solução do cache com custo " << cached.cost << std::endl;
+    }
+
+    // Buscas ALNS independentes, uma por thread, que trocam a melhor solução periodicamente
+    auto neighbors = nearestNeighbors(network, 20);
+    SharedBest shared;
+    std::vector<std::unique_ptr<ALNS<SymmetricNetwork>>> searches;
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        searches.push_back(std::make_unique<ALNS<SymmetricNetwork>>(network, neighbors, max_capacity, max_visits, 1000 + t));
+    }
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() { searches[t]->run(start, shared, time_limit); });
+    }
+    long long iterations = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers[t].join();
+        iterations += searches[t]->iterations;
+    }
+
+    // Finalizando a contagem de tempo
+    auto end_time = std::chrono::high_resolution_clock::now();
+
+    Solution best;
+    best.attach(arena, network.total_nodes);
+    best.fromPath(shared.path, network);
+    cache.store(cache_key, "alns", best.totalCost(), false, shared.path);
+
+    std::cout << std::endl;
+    std::cout << "Rota a ser seguida após a ALNS:" << std::endl;
+    for (int r = 1; r < network.total_nodes; ++r) {
+        if (best.size[r] > 0) {
+            std::cout << "Rota: ";
+            for (int node : best.routeNodes(r)) {
+                std::cout << node << " ";
+            }
+            std::cout << "| Carga: " << best.load[r] << " | Custo da rota: " << best.cost[r] << std::endl;
+        }
+    }
+    std::cout << "Total de rotas: " << best.routeCount() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Detalhamento do custo:" << std::endl;
+    std::cout << "Custo do Clarke e Wright: " << initial_cost << std::endl;
+    std::cout << "Custo total após a ALNS: " << best.totalCost() << " (" << iterations << " iterações em " << threads << " threads)" << std::endl;
+
+    // Calculando o tempo decorrido em segundos com precisão
+    std::chrono::duration<double> duration = end_time - start_time;
+    double execution_time = duration.count();
+
+    // Salvando o tempo de execução em um arquivo de texto
+    std::ofstream time_file("ex6_time.txt", std::ios_base::app); // Abre o arquivo em modo de apêndice
+    if (time_file.is_open()) {
+        time_file << std::fixed << std::setprecision(6) << "Tempo de execução: " << execution_time << " segundos" << std::endl;
+        time_file.close();
+        std::cout << "Tempo de execução de " << execution_time << " salvo em 'ex6_time.txt'" << std::endl;
+    } else {
+        std::cerr << "Erro ao abrir o arquivo para salvar o tempo de execução." << std::endl;
+    }
+
+    return 0;
+}
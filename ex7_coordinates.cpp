@@ -0,0 +1,108 @@
+#include <iostream>
+#include <vector>
+#include <iomanip> // Para configurar a precisão ao escrever no arquivo
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include "coordinate_network.h"
+#include "alns.h"
+#include "solution_cache.h"
+
+int main(int argc, char* argv[]) {
+    CoordinateNetwork network;
+    if (argc < 2 || !network.loadFromFile(argv[1])) {
+        std::cerr << "Uso: ./ex7_coordinates <instancia.vrp> [prazo_alns] [threads] [max_visitas]" << std::endl;
+        return 1;
+    }
+
+    // Parâmetros opcionais: prazo da ALNS em segundos (0 = só Clarke e Wright), threads e limite de visitas
+    double time_limit = argc > 2 ? std::stod(argv[2]) : 0.0;
+    unsigned threads = argc > 3 ? std::stoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    int max_visits = argc > 4 ? std::stoi(argv[4]) : network.total_nodes + 2; // Sem limite por padrão
+    int max_capacity = network.capacity;
+
+    // Iniciando a contagem de tempo
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Listas de candidatos pela grade espacial, usadas pelas economias e pela ALNS
+    auto neighbors = nearestNeighbors(network, 20);
+
+    // Uma arena para as duas soluções do programa: Clarke e Wright e melhor
+    IntArena arena;
+    arena.reserve(2 * Solution::footprint(network.total_nodes));
+    CandidateClarkeWright<CoordinateNetwork> clarke_wright(network, neighbors, max_capacity, max_visits, arena);
+    clarke_wright.solve();
+    int initial_cost = clarke_wright.solution.totalCost();
+
+    Solution best;
+    best.attach(arena, network.total_nodes);
+    best.copyFrom(clarke_wright.solution);
+
+    long long iterations = 0;
+    if (time_limit > 0) {
+        // A ALNS parte da melhor solução guardada no cache para esta instância, se for melhor que o C&W
+        SolutionCache cache;
+        std::string cache_key = cache.key(hashInstance(network), "alns", max_capacity, max_visits);
+        CachedResult cached;
+        // Modelo do ex2: carga <= capacidade e rota + 2 visitas ao depósito <= max_visits
+        if (cache.loadValid(cache_key, network, max_capacity, max_visits - 2, cached) && cached.cost < initial_cost) {
+            best.fromPath(cached.path, network);
+            std::cout << "Partindo da solução do cache com custo " << cached.cost << std::endl;
+        }
+
+        SharedBest shared;
+        std::vector<std::unique_ptr<ALNS<CoordinateNetwork>>> searches;
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            searches.push_back(std::make_unique<ALNS<CoordinateNetwork>>(network, neighbors, max_capacity, max_visits, 1000 + t));
+        }
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() { searches[t]->run(best, shared, time_limit); });
+        }
+        for (unsigned t = 0; t < threads; ++t) {
+            workers[t].join();
+            iterations += searches[t]->iterations;
+        }
+        best.fromPath(shared.path, network);
+        cache.store(cache_key, "alns", best.totalCost(), false, shared.path);
+    }
+
+    // Finalizando a contagem de tempo
+    auto end_time = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Rota a ser seguida:" << std::endl;
+    for (int r = 1; r < network.total_nodes; ++r) {
+        if (best.size[r] > 0) {
+            std::cout << "Rota: ";
+            for (int node : best.routeNodes(r)) {
+                std::cout << node << " ";
+            }
+            std::cout << "| Carga: " << best.load[r] << " | Custo da rota: " << best.cost[r] << std::endl;
+        }
+    }
+    std::cout << "Total de rotas: " << best.routeCount() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Detalhamento do custo:" << std::endl;
+    std::cout << "Custo do Clarke e Wright: " << initial_cost << std::endl;
+    if (time_limit > 0) {
+        std::cout << "Custo total após a ALNS: " << best.totalCost() << " (" << iterations << " iterações em " << threads << " threads)" << std::endl;
+    }
+
+    // Calculando o tempo decorrido em segundos com precisão
+    std::chrono::duration<double> duration = end_time - start_time;
+    double execution_time = duration.count();
+
+    // Salvando o tempo de execução em um arquivo de texto
+    std::ofstream time_file("ex7_time.txt", std::ios_base::app); // Abre o arquivo em modo de apêndice
+    if (time_file.is_open()) {
+        time_file << std::fixed << std::setprecision(6) << "Tempo de execução: " << execution_time << " segundos" << std::endl;
+        time_file.close();
+        std::cout << "Tempo de execução de " << execution_time << " salvo em 'ex7_time.txt'" << std::endl;
+    } else {
+        std::cerr << "Erro ao abrir o arquivo para salvar o tempo de execução." << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,19 @@
+#ifndef NODE_H
+#define NODE_H
+
+#include <vector>
+#include <algorithm>
+
+// Cidade do grafo: id e demanda. Comum aos dois modelos (DirectedNetwork em route_finder.h e
+// SymmetricNetwork em clarke_wright.h), que podem ser incluídos no mesmo programa.
+class Node {
+public:
+    int id;
+    int requirement;
+};
+
+inline bool existsInVector(const std::vector<int>& vec, int value) {
+    return std::find(vec.begin(), vec.end(), value) != vec.end();
+}
+
+#endif
@@ -0,0 +1,751 @@
+#ifndef ROUTE_FINDER_H
+#define ROUTE_FINDER_H
+
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <tuple>
+#include <utility>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <atomic>
+#include <functional>
+#include <array>
+#include <limits>
+#include <memory>
+#include "solution_cache.h"
+#include "node.h"
+
+// Grafo do modelo do ex1 (busca exata): arestas dirigidas, aresta ausente com custo NO_EDGE e carga
+// da rota estritamente menor que a capacidade.
+class DirectedNetwork {
+public:
+    int total_nodes;
+    std::vector<Node> nodes;
+    int total_edges;
+    std::map<int, std::vector<std::pair<int, int>>> adjacency_list;
+    std::vector<std::vector<int>> distance_matrix; // Custo da aresta de -> para, NO_EDGE se ela não existe
+
+    static constexpr int NO_EDGE = 1000000;
+
+    void loadFromFile(const std::string& graph_file, bool verbose = true) {
+        std::ifstream file(graph_file);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao abrir o arquivo" << std::endl;
+            return;
+        }
+        
+        file >> total_nodes;
+        for (int i = 1; i < total_nodes; ++i) {
+            Node node;
+            file >> node.id >> node.requirement;
+            nodes.push_back(node);
+        }
+        
+        distance_matrix.assign(total_nodes, std::vector<int>(total_nodes, NO_EDGE));
+        for (int i = 0; i < total_nodes; ++i) {
+            distance_matrix[i][i] = 0;
+        }
+
+        file >> total_edges;
+        int from, to, weight;
+        for (int i = 0; i < total_edges; ++i) {
+            file >> from >> to >> weight;
+            adjacency_list[from].emplace_back(to, weight);
+            distance_matrix[from][to] = weight; // Grafo dirigido, como na busca
+        }
+
+        file.close();
+
+        if (!verbose) {
+            return;
+        }
+        
+        std::cout << "Informações das Cidades:" << std::endl;
+        for (const auto& node : nodes) {
+            std::cout << "Cidade ID: " << node.id << " | Necessidade: " << node.requirement << std::endl;
+        }
+
+        std::cout << std::endl;
+        
+        std::cout << "Mapa de Rotas:" << std::endl;
+        for (const auto& edge_list : adjacency_list) {
+            std::cout << "Origem " << edge_list.first << " -> ";
+            for (const auto& edge : edge_list.second) {
+                std::cout << "Destino " << edge.first << " (Custo: " << edge.second << ") ";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    int getRequirement(int node_id) const {
+        for (const auto& node : nodes) {
+            if (node.id == node_id) {
+                return node.requirement;
+            }
+        }
+        return 0;
+    }
+
+    void updateRequirement(int node_id, int new_requirement) {
+        for (auto& node : nodes) {
+            if (node.id == node_id) {
+                node.requirement = new_requirement;
+                return;
+            }
+        }
+    }
+
+    int totalRequirements() const {
+        int total = 0;
+        for (const auto& node : nodes) {
+            total += node.requirement;
+        }
+        return total;
+    }
+
+    int distance(int from, int to) const {
+        return distance_matrix[from][to];
+    }
+};
+
+// Núcleo da busca exata especializado em tempo de compilação para instâncias pequenas: até
+// MaxCustomers cidades (no máximo 64), conjuntos de cidades atendidas em um uint64_t e distâncias e
+// adjacências em std::array com pesos do tipo Weight. Percorre a árvore na mesma ordem e com as
+// mesmas podas do RouteFinder, mas recursivamente sobre um único caminho, sem alocar por estado.
+template <int MaxCustomers, typename Weight>
+class SmallRouteFinder {
+public:
+    static_assert(MaxCustomers <= 64, "o conjunto de cidades atendidas precisa caber em um uint64_t");
+    static constexpr int MaxNodes = MaxCustomers + 1;
+
+    int total_nodes;
+    int max_capacity;
+    int max_visits;
+    bool forward_only;
+    bool symmetric;
+
+    std::array<int, MaxNodes> requirement{};
+    std::array<int, MaxNodes> degree{};
+    std::array<std::array<uint8_t, MaxNodes>, MaxNodes> neighbor{};
+    std::array<std::array<Weight, MaxNodes>, MaxNodes> weight{};
+    uint64_t required = 0; // Bit c - 1 ligado para cada cidade c com demanda
+
+    std::array<int, 2 * MaxNodes + 1> path{};
+    int depth = 0;
+    std::vector<int> optimal_route;
+    int minimal_cost = 999999;
+    long long explored = 0;
+    long long pruned = 0;
+
+    // Tabela de transposição com endereçamento aberto. Começa com 2^16 posições e dobra (grow, chamado
+    // de isDominated durante a recursão) quando passa da metade da ocupação: são poucas realocações,
+    // de custo amortizado, e as únicas da busca. Não é pré-dimensionada porque o número de estados
+    // distintos não tem um limite útil a priori (o teto seria max_table_entries mesmo em instâncias minúsculas).
+    struct Entry {
+        uint64_t served;
+        uint64_t position;
+        int cost; // -1 marca posição livre
+    };
+    std::vector<Entry> table;
+    size_t table_used = 0;
+    size_t max_table_entries = 1 << 22;
+
+    SmallRouteFinder(const DirectedNetwork& network, int cap, int visits, bool forward, bool sym)
+        : total_nodes(network.total_nodes), max_capacity(cap), max_visits(visits), forward_only(forward), symmetric(sym) {
+        for (const auto& node : network.nodes) {
+            requirement[node.id] = node.requirement;
+            if (node.requirement != 0) {
+                required |= uint64_t(1) << (node.id - 1);
+            }
+        }
+        for (const auto& edge_list : network.adjacency_list) {
+            int from = edge_list.first;
+            for (const auto& edge : edge_list.second) {
+                neighbor[from][degree[from]] = static_cast<uint8_t>(edge.first);
+                weight[from][degree[from]] = static_cast<Weight>(edge.second);
+                ++degree[from];
+            }
+        }
+        table.assign(1 << 16, Entry{0, 0, -1});
+    }
+
+    // A instância cabe neste núcleo? (ids em faixa, grau por nó e pesos representáveis em Weight)
+    static bool fits(const DirectedNetwork& network) {
+        if (network.total_nodes > MaxNodes) {
+            return false;
+        }
+        for (const auto& edge_list : network.adjacency_list) {
+            if (edge_list.first < 0 || edge_list.first >= network.total_nodes || edge_list.second.size() > MaxNodes) {
+                return false;
+            }
+            for (const auto& edge : edge_list.second) {
+                if (edge.first < 0 || edge.first >= network.total_nodes || edge.second < 0 ||
+                    edge.second > std::numeric_limits<Weight>::max()) {
+                    return false;
+                }
+            }
+        }
+        for (const auto& node : network.nodes) {
+            if (node.id < 1 || node.id >= network.total_nodes) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void solve() {
+        path[0] = 0;
+        depth = 1;
+        search(0, 0, max_capacity, 0, 0, 0, 0);
+    }
+
+    static uint64_t hash(uint64_t served, uint64_t position) {
+        uint64_t h = served * 0x9E3779B97F4A7C15ULL ^ (position + 0x632BE59BD9B4E019ULL) * 0xC2B2AE3D27D4EB4FULL;
+        return h ^ (h >> 29);
+    }
+
+    // Dobra a tabela e reinsere as entradas. Chamado no meio da busca, no máximo log2(max_table_entries / 2^15) vezes.
+    void grow() {
+        std::vector<Entry> old(table.size() * 2, Entry{0, 0, -1});
+        old.swap(table);
+        size_t mask = table.size() - 1;
+        for (const auto& entry : old) {
+            if (entry.cost < 0) continue;
+            size_t slot = hash(entry.served, entry.position) & mask;
+            while (table[slot].cost >= 0) slot = (slot + 1) & mask;
+            table[slot] = entry;
+        }
+    }
+
+    bool isDominated(uint64_t served, uint64_t position, int cost) {
+        size_t mask = table.size() - 1;
+        size_t slot = hash(served, position) & mask;
+        while (table[slot].cost >= 0) {
+            if (table[slot].served == served && table[slot].position == position) {
+                if (table[slot].cost <= cost) {
+                    return true;
+                }
+                table[slot].cost = cost;
+                return false;
+            }
+            slot = (slot + 1) & mask;
+        }
+        if (table_used >= max_table_entries) {
+            return false;
+        }
+        table[slot] = Entry{served, position, cost};
+        if (++table_used * 2 > table.size()) {
+            grow();
+        }
+        return false;
+    }
+
+    void search(int node, int cost, int remaining_capacity, int visited_count, uint64_t served, int route_first, int route_min) {
+        ++explored;
+        uint64_t pending = required & ~served;
+
+        if (node == 0 && depth > 1 && pending == 0) {
+            if (cost < minimal_cost) {
+                minimal_cost = cost;
+                optimal_route.assign(path.begin(), path.begin() + depth);
+            }
+            return;
+        }
+        if (cost >= minimal_cost) {
+            ++pruned;
+            return;
+        }
+
+        uint64_t key_route = forward_only ? 0 : uint64_t(route_first) << 40 | uint64_t(route_min) << 48;
+        uint64_t position = uint64_t(node) | uint64_t(remaining_capacity) << 8 | uint64_t(visited_count) << 32 | key_route;
+        if (isDominated(served, position, cost)) {
+            ++pruned;
+            return;
+        }
+
+        int lowest_unserved = pending != 0 ? __builtin_ctzll(pending) + 1 : total_nodes;
+
+        for (int k = 0; k < degree[node]; ++k) {
+            int next_node = neighbor[node][k];
+            int travel_cost = weight[node][k];
+
+            if (next_node != 0) {
+                uint64_t bit = uint64_t(1) << (next_node - 1);
+                int node_requirement = (served & bit) ? 0 : requirement[next_node];
+                if (visited_count + 1 > max_visits || remaining_capacity - node_requirement <= 0 || node_requirement == 0) {
+                    continue;
+                }
+                if (node == 0 && forward_only && next_node != lowest_unserved) {
+                    continue;
+                }
+                path[depth++] = next_node;
+                search(next_node, cost + travel_cost, remaining_capacity - node_requirement, visited_count + 1, served | bit,
+                       node == 0 ? next_node : route_first, node == 0 ? next_node : std::min(route_min, next_node));
+                --depth;
+            } else {
+                if (node != 0) {
+                    if (!forward_only && route_min > lowest_unserved) {
+                        continue;
+                    }
+                    if (symmetric && route_first > node) {
+                        continue;
+                    }
+                }
+                path[depth++] = 0;
+                search(0, cost + travel_cost, max_capacity, 0, served, 0, 0);
+                --depth;
+                if (pending == 0) {
+                    break;
+                }
+            }
+        }
+    }
+};
+
+// Subproblema aberto da busca: o caminho percorrido até agora e o estado do veículo no fim dele.
+struct SearchState {
+    int cost;
+    int current_node;
+    int remaining_capacity;
+    int visited_count;
+    std::vector<int> visited_nodes;
+};
+
+class RouteFinder {
+public:
+    DirectedNetwork network;
+    int max_capacity;
+    int max_visits;
+
+    // Fronteira da busca em profundidade (pilha explícita) e melhor solução encontrada
+    std::vector<SearchState> frontier;
+    std::vector<int> optimal_route;
+    int minimal_cost = 999999;
+    long long explored = 0;
+    long long pruned = 0;
+
+    // Demanda de cada cidade indexada pelo id e buffer reaproveitado para os filhos de um estado
+    std::vector<int> requirement_of;
+    std::vector<SearchState> children;
+
+    // Simetrias do grafo: arestas entre cidades só vão de um id menor para um maior
+    // (toda rota começa pela sua menor cidade) e/ou toda aresta tem a volta com o mesmo custo
+    bool forward_only = true;
+    bool symmetric = true;
+
+    // Chave: (cidades atendidas, posição/capacidade/visitas/rota atual) -> menor custo expandido
+    std::map<std::pair<uint64_t, uint64_t>, int> transposition;
+    size_t max_transposition_entries = 1 << 22;
+
+    // Salvamento periódico: intervalo em segundos e arquivo ("" desativa)
+    std::string checkpoint_file;
+    double checkpoint_interval = 30.0;
+    bool checkpoint_saved = false; // Se a gravação ao interromper a busca deu certo
+
+    // Cooperação com outros resolvedores: custo da melhor solução conhecida por fora (usado
+    // como limite de poda), pedido de cancelamento e aviso a cada nova incumbente
+    const std::atomic<int>* external_bound = nullptr;
+    const std::atomic<bool>* cancel = nullptr;
+    std::function<void(const std::vector<int>&, int)> on_improvement;
+
+    RouteFinder(DirectedNetwork net, int cap, int visits) : network(net), max_capacity(cap), max_visits(visits) {
+        requirement_of.assign(network.total_nodes + 1, 0);
+        for (const auto& node : network.nodes) {
+            requirement_of[node.id] = node.requirement;
+        }
+
+        for (const auto& edge_list : network.adjacency_list) {
+            int from = edge_list.first;
+            for (const auto& edge : edge_list.second) {
+                if (from != 0 && edge.first != 0 && from > edge.first) {
+                    forward_only = false;
+                }
+                bool has_return = false;
+                for (const auto& back : network.adjacency_list[edge.first]) {
+                    if (back.first == from && back.second == edge.second) {
+                        has_return = true;
+                    }
+                }
+                if (!has_return) {
+                    symmetric = false;
+                }
+            }
+        }
+    }
+
+    // Marca as cidades atendidas pelo caminho e devolve a menor cidade com demanda ainda não atendida
+    // (total_nodes se todas já foram atendidas). O chamador deve desmarcar com unmarkServed.
+    int markServed(const SearchState& state, std::vector<int>& served) const {
+        for (int node : state.visited_nodes) {
+            served[node] = 1;
+        }
+        int lowest_unserved = network.total_nodes;
+        for (const auto& node : network.nodes) {
+            if (requirement_of[node.id] != 0 && !served[node.id] && node.id < lowest_unserved) {
+                lowest_unserved = node.id;
+            }
+        }
+        return lowest_unserved;
+    }
+
+    void unmarkServed(const SearchState& state, std::vector<int>& served) const {
+        for (int node : state.visited_nodes) {
+            served[node] = 0;
+        }
+    }
+
+    // Primeira e menor cidade da rota em andamento (0 se o veículo está no depósito).
+    void currentRoute(const SearchState& state, int& route_first, int& route_min) const {
+        route_first = route_min = 0;
+        for (auto it = state.visited_nodes.rbegin(); it != state.visited_nodes.rend() && *it != 0; ++it) {
+            route_first = *it;
+            route_min = route_min == 0 ? *it : std::min(route_min, *it);
+        }
+    }
+
+    // Gera os filhos de um estado na mesma ordem da busca recursiva original, descartando
+    // os que só repetem, em outra ordem ou sentido, rotas já enumeradas.
+    // Os filhos são empilhados em ordem inversa para que o primeiro seja expandido primeiro.
+    void expand(const SearchState& state, std::vector<int>& served) {
+        int lowest_unserved = markServed(state, served);
+        bool all_served = lowest_unserved == network.total_nodes;
+
+        int route_first, route_min;
+        currentRoute(state, route_first, route_min);
+
+        children.clear();
+        for (const auto& edge : network.adjacency_list[state.current_node]) {
+            int next_node = edge.first;
+            int travel_cost = edge.second;
+
+            int node_requirement = served[next_node] ? 0 : requirement_of[next_node];
+
+            if (next_node != 0 && (state.visited_count + 1 > max_visits || state.remaining_capacity - node_requirement <= 0)) {
+                continue;
+            }
+            if (next_node != 0 && node_requirement == 0) {
+                continue; // Cidade já atendida
+            }
+
+            if (next_node != 0 && state.current_node == 0 && forward_only && next_node != lowest_unserved) {
+                continue; // Ordem canônica: cada nova rota começa pela menor cidade não atendida
+            }
+            if (next_node == 0 && state.current_node != 0) {
+                if (!forward_only && route_min > lowest_unserved) {
+                    continue; // Ordem canônica: a rota precisa conter a menor cidade pendente quando começou
+                }
+                if (symmetric && route_first != state.current_node && route_first > state.current_node) {
+                    continue; // Sentido canônico: a rota invertida tem o mesmo custo
+                }
+            }
+
+            SearchState child{state.cost + travel_cost, next_node, max_capacity, 0, {}};
+            child.visited_nodes.reserve(state.visited_nodes.size() + 1);
+            child.visited_nodes = state.visited_nodes;
+            child.visited_nodes.push_back(next_node);
+
+            if (next_node == 0) {
+                children.push_back(std::move(child));
+                if (all_served) {
+                    break; // Solução completa: os demais ramos deste nó não são explorados
+                }
+            } else {
+                child.remaining_capacity = state.remaining_capacity - node_requirement;
+                child.visited_count = state.visited_count + 1;
+                children.push_back(std::move(child));
+            }
+        }
+
+        unmarkServed(state, served);
+
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            frontier.push_back(std::move(*it));
+        }
+    }
+
+    int currentBound() const {
+        if (external_bound == nullptr) {
+            return minimal_cost;
+        }
+        return std::min(minimal_cost, external_bound->load(std::memory_order_relaxed));
+    }
+
+    bool isComplete(const SearchState& state, std::vector<int>& served) const {
+        if (state.current_node != 0 || state.visited_nodes.size() < 2) {
+            return false;
+        }
+        bool complete = markServed(state, served) == network.total_nodes;
+        unmarkServed(state, served);
+        return complete;
+    }
+
+    // Tabela de transposição: um estado é dominado se outro com as mesmas cidades atendidas,
+    // mesma posição, capacidade e visitas restantes (e mesma rota em andamento, quando a
+    // ordem canônica depende dela) já foi expandido com custo menor ou igual.
+    bool isDominated(const SearchState& state) {
+        if (network.total_nodes > 64 || transposition.size() >= max_transposition_entries) {
+            return false;
+        }
+
+        uint64_t served_mask = 0;
+        for (int node : state.visited_nodes) {
+            served_mask |= uint64_t(1) << node;
+        }
+        int route_first = 0, route_min = 0;
+        if (!forward_only) {
+            currentRoute(state, route_first, route_min);
+        }
+        uint64_t position = uint64_t(state.current_node) | uint64_t(state.remaining_capacity) << 8 |
+                            uint64_t(state.visited_count) << 32 | uint64_t(route_first) << 40 | uint64_t(route_min) << 48;
+
+        auto [entry, inserted] = transposition.try_emplace(std::make_pair(served_mask, position), state.cost);
+        if (!inserted) {
+            if (entry->second <= state.cost) {
+                return true;
+            }
+            entry->second = state.cost;
+        }
+        return false;
+    }
+
+    // Processa a fronteira até esvaziá-la, até o prazo ou até ser cancelada.
+    // Retorna true se a busca terminou (a melhor solução conhecida é ótima).
+    bool run(double time_limit) {
+        auto start = std::chrono::steady_clock::now();
+        auto last_checkpoint = start;
+        std::vector<int> served(network.total_nodes + 1, 0);
+        int bound = currentBound();
+
+        while (!frontier.empty()) {
+            if ((explored & 0xFFF) == 0) {
+                auto now = std::chrono::steady_clock::now();
+                bool expired = time_limit > 0 && std::chrono::duration<double>(now - start).count() >= time_limit;
+                if (expired || (cancel != nullptr && cancel->load(std::memory_order_relaxed))) {
+                    checkpoint_saved = saveCheckpoint();
+                    return false;
+                }
+                if (std::chrono::duration<double>(now - last_checkpoint).count() >= checkpoint_interval) {
+                    saveCheckpoint();
+                    last_checkpoint = now;
+                }
+                bound = currentBound();
+            }
+
+            SearchState state = std::move(frontier.back());
+            frontier.pop_back();
+            ++explored;
+
+            if (isComplete(state, served)) {
+                if (state.cost < minimal_cost) {
+                    optimal_route = state.visited_nodes;
+                    minimal_cost = state.cost;
+                    bound = currentBound();
+                    if (on_improvement) {
+                        on_improvement(optimal_route, minimal_cost);
+                    }
+                }
+                continue;
+            }
+
+            if (state.cost >= bound) {
+                ++pruned; // Nenhuma extensão deste caminho pode superar a incumbente
+                continue;
+            }
+            if (isDominated(state)) {
+                ++pruned;
+                continue;
+            }
+
+            expand(state, served);
+        }
+
+        if (!checkpoint_file.empty()) {
+            std::remove(checkpoint_file.c_str()); // Busca concluída: nada a retomar
+        }
+        return true;
+    }
+
+    // Grava fronteira, incumbente e contadores em texto. Escreve em um arquivo temporário
+    // e renomeia, para que uma interrupção no meio da escrita não corrompa o checkpoint anterior.
+    // O cabeçalho leva o hash da instância (demandas e arestas) para que o checkpoint não seja
+    // retomado em outro grafo com o mesmo número de cidades. A tabela de transposição não é gravada: ao
+    // retomar ela recomeça vazia e estados já descartados como dominados podem ser explorados de novo.
+    // Se a escrita falhar (disco cheio, limite de tamanho), o temporário é apagado e o checkpoint
+    // anterior é mantido. Retorna true se gravou.
+    bool saveCheckpoint() const {
+        if (checkpoint_file.empty()) {
+            return false;
+        }
+        std::string temp_file = checkpoint_file + ".tmp";
+        std::ofstream file(temp_file);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao abrir o arquivo de checkpoint" << std::endl;
+            return false;
+        }
+
+        file << "checkpoint " << network.total_nodes << " " << max_capacity << " " << max_visits << " "
+             << std::hex << hashInstance(network) << std::dec << std::endl;
+        file << "explorados " << explored << std::endl;
+        file << "incumbente " << minimal_cost << " " << optimal_route.size();
+        for (int node : optimal_route) {
+            file << " " << node;
+        }
+        file << std::endl;
+
+        file << "abertos " << frontier.size() << std::endl;
+        for (const auto& state : frontier) {
+            file << state.cost << " " << state.current_node << " " << state.remaining_capacity << " "
+                 << state.visited_count << " " << state.visited_nodes.size();
+            for (int node : state.visited_nodes) {
+                file << " " << node;
+            }
+            file << std::endl;
+        }
+        file.flush();
+        bool written = file.good();
+        file.close();
+        if (!written || file.fail()) {
+            std::cerr << "Erro ao gravar o checkpoint; mantendo o anterior em '" << checkpoint_file << "'" << std::endl;
+            std::remove(temp_file.c_str());
+            return false;
+        }
+
+        if (std::rename(temp_file.c_str(), checkpoint_file.c_str()) != 0) {
+            std::cerr << "Erro ao substituir o checkpoint '" << checkpoint_file << "'" << std::endl;
+            std::remove(temp_file.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Restaura a busca a partir do checkpoint. Retorna false se não há checkpoint compatível.
+    bool loadCheckpoint() {
+        std::ifstream file(checkpoint_file);
+        if (checkpoint_file.empty() || !file.is_open()) {
+            return false;
+        }
+
+        std::string label;
+        int nodes, capacity, visits;
+        uint64_t fingerprint = 0;
+        file >> label >> nodes >> capacity >> visits >> std::hex >> fingerprint >> std::dec;
+        if (!file || label != "checkpoint" || nodes != network.total_nodes || capacity != max_capacity || visits != max_visits ||
+            fingerprint != hashInstance(network)) {
+            std::cerr << "Checkpoint incompatível com a instância, ignorando" << std::endl;
+            return false;
+        }
+
+        size_t count;
+        int saved_cost;
+        file >> label >> explored;
+        file >> label >> saved_cost >> count;
+        std::vector<int> saved_route(count, 0);
+        for (auto& node : saved_route) {
+            file >> node;
+        }
+
+        file >> label >> count;
+        frontier.assign(count, SearchState{});
+        for (auto& state : frontier) {
+            size_t length;
+            file >> state.cost >> state.current_node >> state.remaining_capacity >> state.visited_count >> length;
+            state.visited_nodes.assign(length, 0);
+            for (auto& node : state.visited_nodes) {
+                file >> node;
+            }
+        }
+
+        if (!file) {
+            std::cerr << "Checkpoint truncado, ignorando" << std::endl;
+            frontier.clear();
+            explored = 0;
+            return false;
+        }
+        if (saved_cost < minimal_cost) { // Mantém a incumbente inicial (do cache) se ela for melhor
+            minimal_cost = saved_cost;
+            optimal_route = saved_route;
+        }
+        return true;
+    }
+
+    template <int MaxCustomers, typename Weight>
+    bool solveSmall() {
+        if (!SmallRouteFinder<MaxCustomers, Weight>::fits(network)) {
+            return false;
+        }
+        auto kernel = std::make_unique<SmallRouteFinder<MaxCustomers, Weight>>(network, max_capacity, max_visits, forward_only, symmetric);
+        kernel->minimal_cost = minimal_cost;
+        kernel->solve();
+        if (kernel->minimal_cost < minimal_cost) {
+            minimal_cost = kernel->minimal_cost;
+            optimal_route = kernel->optimal_route;
+        }
+        explored += kernel->explored;
+        pruned += kernel->pruned;
+        return true;
+    }
+
+    // Escolhe em tempo de execução a instância do núcleo especializado que cabe no grafo.
+    // Retorna false se nenhuma cabe e a busca genérica precisa ser usada.
+    bool solveWithSmallKernel() {
+        if (network.total_nodes <= 17 && (solveSmall<16, int16_t>() || solveSmall<16, int>())) {
+            return true;
+        }
+        return solveSmall<64, int16_t>() || solveSmall<64, int>();
+    }
+
+    // Resolve e imprime a melhor solução. Retorna true se a busca terminou (otimalidade comprovada).
+    // Uma incumbente já presente em optimal_route/minimal_cost é usada como limite inicial.
+    bool discoverOptimalRoute(double time_limit) {
+        // Caso comum: instância pequena, sem prazo nem checkpoint, resolvida pelo núcleo especializado
+        if (time_limit <= 0 && checkpoint_file.empty() && solveWithSmallKernel()) {
+            printSolution();
+            return true;
+        }
+
+        if (loadCheckpoint()) {
+            std::cout << "Retomando do checkpoint: " << frontier.size() << " subproblemas abertos, "
+                      << explored << " estados já explorados" << std::endl << std::endl;
+        } else {
+            frontier.push_back(SearchState{0, 0, max_capacity, 0, {0}});
+        }
+
+        bool finished = run(time_limit);
+
+        if (!finished) {
+            std::cout << "Limite de tempo atingido: busca interrompida" << std::endl;
+            std::cout << "Subproblemas em aberto: " << frontier.size() << " | Estados explorados: " << explored << std::endl;
+            if (checkpoint_saved) {
+                std::cout << "Estado salvo em '" << checkpoint_file << "'" << std::endl;
+            } else if (!checkpoint_file.empty()) {
+                std::cout << "Não foi possível salvar o estado em '" << checkpoint_file << "'" << std::endl;
+            }
+            std::cout << "Melhor solução encontrada até agora (não comprovadamente ótima):" << std::endl;
+            std::cout << std::endl;
+        }
+
+        printSolution();
+        return finished;
+    }
+
+    void printSolution() const {
+        std::cout << "Rota a ser seguida:" << std::endl;
+        for (size_t i = 0; i < optimal_route.size(); ++i) {
+            std::cout << "Passo " << i + 1 << ": Cidade " << optimal_route[i] << std::endl;
+        }
+        std::cout << "Total de passos: " << optimal_route.size() << std::endl;
+        std::cout << std::endl;
+
+        std::cout << "Detalhamento do custo:" << std::endl;
+        std::cout << "Custo total para percorrer a rota ótima: " << minimal_cost << std::endl;
+        std::cout << "Isso inclui os custos de viagem entre todas as cidades na rota." << std::endl;
+    }
+};
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef SOLUTION_H
+#define SOLUTION_H
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+
+// Arena de inteiros: um único bloco reservado uma vez pelo dono (reserve) e fatiado entre os arrays
+// de todas as soluções que ele usa, por exemplo reserve(k * Solution::footprint(n)) para k soluções.
+// Chamar reserve() ou reset() de novo reaproveita a mesma memória em outra execução.
+class IntArena {
+public:
+    std::vector<int> buffer;
+    size_t used = 0;
+
+    void reserve(size_t count) {
+        if (buffer.size() < count) {
+            buffer.resize(count);
+        }
+        used = 0;
+    }
+
+    int* allocate(size_t count) {
+        if (used + count > buffer.size()) {
+            return nullptr;
+        }
+        int* block = buffer.data() + used;
+        used += count;
+        return block;
+    }
+
+    void reset() {
+        used = 0;
+    }
+};
+
+// Representação plana de um conjunto de rotas que partem e voltam ao depósito (nó 0).
+// Cada cliente guarda seu sucessor, antecessor e a rota a que pertence; cada rota guarda
+// início, fim, carga, custo e quantidade de clientes. next/prev iguais a 0 indicam o depósito.
+// Os identificadores de rota vão de 1 a total_nodes - 1 e rotas vazias têm size == 0.
+class Solution {
+public:
+    static constexpr int ARRAYS = 8;
+
+    int total_nodes = 0;
+    int* next = nullptr;
+    int* prev = nullptr;
+    int* route_id = nullptr;
+    int* head = nullptr;
+    int* tail = nullptr;
+    int* load = nullptr;
+    int* cost = nullptr;
+    int* size = nullptr;
+
+    // Inteiros que uma solução com 'nodes' cidades ocupa na arena.
+    static size_t footprint(int nodes) {
+        return static_cast<size_t>(ARRAYS) * nodes;
+    }
+
+    // Toma os arrays da arena, que já deve ter sido reservada pelo dono com espaço para esta solução.
+    void attach(IntArena& arena, int nodes) {
+        if (arena.used + footprint(nodes) > arena.buffer.size()) {
+            std::cerr << "Arena sem espaço para mais uma solução: reserve Solution::footprint(n) por solução" << std::endl;
+            std::abort();
+        }
+        total_nodes = nodes;
+        next = arena.allocate(nodes);
+        prev = arena.allocate(nodes);
+        route_id = arena.allocate(nodes);
+        head = arena.allocate(nodes);
+        tail = arena.allocate(nodes);
+        load = arena.allocate(nodes);
+        cost = arena.allocate(nodes);
+        size = arena.allocate(nodes);
+        clear();
+    }
+
+    // Remove todas as rotas, deixando os clientes sem rota (route_id == 0).
+    void clear() {
+        for (int i = 0; i < total_nodes; ++i) {
+            next[i] = prev[i] = route_id[i] = 0;
+            head[i] = tail[i] = load[i] = cost[i] = size[i] = 0;
+        }
+    }
+
+    // Solução inicial de Clarke e Wright: uma rota 0 -> i -> 0 por cliente, com id de rota i.
+    template <typename Net>
+    void startSingletons(const Net& network) {
+        clear();
+        for (int i = 1; i < total_nodes; ++i) {
+            route_id[i] = i;
+            head[i] = tail[i] = i;
+            load[i] = network.nodes[i].requirement;
+            cost[i] = network.distance(0, i) + network.distance(i, 0);
+            size[i] = 1;
+        }
+    }
+
+    // Acrescenta o cliente no fim da rota r, atualizando carga e custo em O(1).
+    template <typename Net>
+    void append(int r, int node, const Net& network, int demand) {
+        int last = tail[r];
+        if (size[r] == 0) {
+            head[r] = node;
+            cost[r] = network.distance(0, node) + network.distance(node, 0);
+        } else {
+            next[last] = node;
+            cost[r] += network.distance(last, node) + network.distance(node, 0) - network.distance(last, 0);
+        }
+        prev[node] = size[r] == 0 ? 0 : last;
+        next[node] = 0;
+        tail[r] = node;
+        route_id[node] = r;
+        load[r] += demand;
+        size[r] += 1;
+    }
+
+    // Concatena a rota rj depois da rota ri (fim de ri ligado ao início de rj) e esvazia rj.
+    template <typename Net>
+    void merge(int ri, int rj, const Net& network) {
+        int a = tail[ri];
+        int b = head[rj];
+        cost[ri] += cost[rj] + network.distance(a, b) - network.distance(a, 0) - network.distance(0, b);
+        next[a] = b;
+        prev[b] = a;
+        tail[ri] = tail[rj];
+        load[ri] += load[rj];
+        size[ri] += size[rj];
+        for (int node = b; node != 0; node = next[node]) {
+            route_id[node] = ri;
+        }
+        head[rj] = tail[rj] = load[rj] = cost[rj] = size[rj] = 0;
+    }
+
+    // Retira o cliente da sua rota, religando os vizinhos.
+    template <typename Net>
+    void remove(int node, const Net& network, int demand) {
+        int r = route_id[node];
+        int p = prev[node];
+        int n = next[node];
+        cost[r] += network.distance(p, n) - network.distance(p, node) - network.distance(node, n);
+        if (p == 0) head[r] = n; else next[p] = n;
+        if (n == 0) tail[r] = p; else prev[n] = p;
+        load[r] -= demand;
+        size[r] -= 1;
+        if (size[r] == 0) cost[r] = 0;
+        next[node] = prev[node] = route_id[node] = 0;
+    }
+
+    // Insere o cliente na rota r logo depois de 'after' (0 = logo após o depósito).
+    template <typename Net>
+    void insertAfter(int r, int after, int node, const Net& network, int demand) {
+        if (size[r] == 0) {
+            append(r, node, network, demand);
+            return;
+        }
+        int n = after == 0 ? head[r] : next[after];
+        cost[r] += network.distance(after, node) + network.distance(node, n) - network.distance(after, n);
+        prev[node] = after;
+        next[node] = n;
+        if (after == 0) head[r] = node; else next[after] = node;
+        if (n == 0) tail[r] = node; else prev[n] = node;
+        route_id[node] = r;
+        load[r] += demand;
+        size[r] += 1;
+    }
+
+    // Inverte o sentido da rota r e recalcula seu custo (o mesmo de antes em grafos simétricos).
+    template <typename Net>
+    void reverse(int r, const Net& network) {
+        int node = head[r];
+        while (size[r] > 0 && node != 0) {
+            int following = next[node];
+            std::swap(next[node], prev[node]);
+            node = following;
+        }
+        std::swap(head[r], tail[r]);
+        cost[r] = 0;
+        int last = 0;
+        for (node = head[r]; size[r] > 0 && node != 0; node = next[node]) {
+            cost[r] += network.distance(last, node);
+            last = node;
+        }
+        if (size[r] > 0) {
+            cost[r] += network.distance(last, 0);
+        }
+    }
+
+    // Custo de inserir o cliente entre 'after' e seu sucessor na rota r.
+    template <typename Net>
+    int insertionDelta(int r, int after, int node, const Net& network) const {
+        if (size[r] == 0) {
+            return network.distance(0, node) + network.distance(node, 0);
+        }
+        int n = after == 0 ? head[r] : next[after];
+        return network.distance(after, node) + network.distance(node, n) - network.distance(after, n);
+    }
+
+    int totalCost() const {
+        int total = 0;
+        for (int r = 1; r < total_nodes; ++r) {
+            total += cost[r];
+        }
+        return total;
+    }
+
+    int routeCount() const {
+        int count = 0;
+        for (int r = 1; r < total_nodes; ++r) {
+            if (size[r] > 0) ++count;
+        }
+        return count;
+    }
+
+    // Copia as rotas de outra solução com o mesmo número de cidades (sem alocar).
+    void copyFrom(const Solution& other) {
+        std::copy(other.next, other.next + total_nodes, next);
+        std::copy(other.prev, other.prev + total_nodes, prev);
+        std::copy(other.route_id, other.route_id + total_nodes, route_id);
+        std::copy(other.head, other.head + total_nodes, head);
+        std::copy(other.tail, other.tail + total_nodes, tail);
+        std::copy(other.load, other.load + total_nodes, load);
+        std::copy(other.cost, other.cost + total_nodes, cost);
+        std::copy(other.size, other.size + total_nodes, size);
+    }
+
+    // Todas as rotas em sequência, no formato da busca exata: 0 c1 c2 0 c3 0 ...
+    std::vector<int> toPath() const {
+        std::vector<int> path = {0};
+        for (int r = 1; r < total_nodes; ++r) {
+            for (int node = head[r]; size[r] > 0 && node != 0; node = next[node]) {
+                path.push_back(node);
+            }
+            if (size[r] > 0) {
+                path.push_back(0);
+            }
+        }
+        return path;
+    }
+
+    // Reconstrói as rotas a partir do formato de toPath, numerando-as a partir de 1.
+    template <typename Net>
+    void fromPath(const std::vector<int>& path, const Net& network) {
+        rebuild(path, network, [&](int node) { return network.nodes[node].requirement; });
+    }
+
+    // Mesma reconstrução para redes cujo vetor nodes não é indexado pelo id (como a do ex1):
+    // a demanda de cada cidade vem de 'demand', indexado pelo id.
+    template <typename Net>
+    void fromPath(const std::vector<int>& path, const Net& network, const std::vector<int>& demand) {
+        rebuild(path, network, [&](int node) { return demand[node]; });
+    }
+
+    // Rota r no formato usado na impressão: 0 c1 c2 ... 0.
+    std::vector<int> routeNodes(int r) const {
+        std::vector<int> route = {0};
+        for (int node = head[r]; size[r] > 0 && node != 0; node = next[node]) {
+            route.push_back(node);
+        }
+        route.push_back(0);
+        return route;
+    }
+
+private:
+    template <typename Net, typename DemandOf>
+    void rebuild(const std::vector<int>& path, const Net& network, DemandOf demand_of) {
+        clear();
+        int r = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            if (path[i] == 0) {
+                continue;
+            }
+            if (path[i - 1] == 0) {
+                ++r;
+            }
+            append(r, path[i], network, demand_of(path[i]));
+        }
+    }
+};
+
+#endif
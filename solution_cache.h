@@ -0,0 +1,256 @@
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+// Hash FNV-1a de 64 bits, alimentado campo a campo.
+class InstanceHasher {
+public:
+    uint64_t value = 1469598103934665603ULL;
+
+    void add(const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; ++i) {
+            value ^= bytes[i];
+            value *= 1099511628211ULL;
+        }
+    }
+
+    void add(int64_t number) {
+        add(&number, sizeof(number));
+    }
+
+    void add(double number) {
+        uint64_t bits;
+        std::memcpy(&bits, &number, sizeof(bits));
+        add(&bits, sizeof(bits));
+    }
+
+    void add(const std::string& text) {
+        add(static_cast<int64_t>(text.size()));
+        add(text.data(), text.size());
+    }
+};
+
+// Hash da instância já carregada (e não do arquivo), de modo que a ordem das arestas, espaços e
+// comentários não mudam a chave: número de cidades, demandas ordenadas por id e a matriz de distâncias
+// completa, como o resolvedor a enxerga. Serve para os grafos com matriz (ex1 e ex2); as instâncias por
+// coordenadas têm a própria sobrecarga em coordinate_network.h.
+template <typename Net>
+uint64_t hashInstance(const Net& network) {
+    InstanceHasher hasher;
+    hasher.add(static_cast<int64_t>(network.total_nodes));
+    std::vector<std::pair<int, int>> demands;
+    for (const auto& node : network.nodes) {
+        if (node.requirement != 0) {
+            demands.emplace_back(node.id, node.requirement);
+        }
+    }
+    std::sort(demands.begin(), demands.end());
+    for (const auto& [id, requirement] : demands) {
+        hasher.add(static_cast<int64_t>(id));
+        hasher.add(static_cast<int64_t>(requirement));
+    }
+    for (int i = 0; i < network.total_nodes; ++i) {
+        for (int j = 0; j < network.total_nodes; ++j) {
+            hasher.add(static_cast<int64_t>(network.distance(i, j)));
+        }
+    }
+    return hasher.value;
+}
+
+// Demanda de cada cidade indexada pelo número usado nos caminhos (o id, nos grafos com matriz; as
+// instâncias por coordenadas têm a própria sobrecarga em coordinate_network.h).
+template <typename Net>
+std::vector<int> demandById(const Net& network) {
+    std::vector<int> demand(network.total_nodes, 0);
+    for (const auto& node : network.nodes) {
+        if (node.id >= 0 && node.id < network.total_nodes) {
+            demand[node.id] = node.requirement;
+        }
+    }
+    return demand;
+}
+
+// Confere um caminho do cache antes de usá-lo: ids em [0, n), começa e termina no depósito, cada cliente
+// com demanda aparece exatamente uma vez (nenhuma cidade se repete) e cada rota tem carga <= max_load e no
+// máximo max_customers clientes. Os limites são inclusivos: cada chamador traduz as regras do seu modelo.
+template <typename Net>
+bool validPath(const Net& network, const std::vector<int>& path, int max_load, int max_customers) {
+    int n = network.total_nodes;
+    if (path.size() < 2 || path.front() != 0 || path.back() != 0) {
+        return false;
+    }
+    std::vector<int> demand = demandById(network);
+    std::vector<char> seen(n, 0);
+    int load = 0, customers = 0;
+    for (int node : path) {
+        if (node < 0 || node >= n) {
+            return false;
+        }
+        if (node == 0) {
+            load = customers = 0;
+            continue;
+        }
+        if (seen[node]) {
+            return false;
+        }
+        seen[node] = 1;
+        load += demand[node];
+        ++customers;
+        if (load > max_load || customers > max_customers) {
+            return false;
+        }
+    }
+    for (int node = 1; node < n; ++node) {
+        if (demand[node] != 0 && !seen[node]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Custo de um caminho no formato 0 c1 c2 0 c3 0 ..., para conferir uma entrada antes de usá-la.
+// Só deve ser chamado depois de validPath, que garante os ids dentro da instância.
+template <typename Net>
+int pathCost(const Net& network, const std::vector<int>& path) {
+    int total = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        total += network.distance(path[i - 1], path[i]);
+    }
+    return total;
+}
+
+struct CachedResult {
+    int cost = 0;
+    bool optimal = false;
+    std::vector<int> path;
+};
+
+// Cache de resultados em disco: um arquivo por chave em 'directory' (variável de ambiente
+// VRP_CACHE_DIR, padrão "cache"; vazia desativa o cache). A chave combina o hash da instância, o
+// resolvedor, a capacidade e o limite de visitas. Uma solução com otimalidade comprovada nunca é
+// substituída; as demais só são trocadas por uma de custo menor ou comprovadamente ótima.
+class SolutionCache {
+public:
+    static constexpr int FORMAT_VERSION = 1;
+
+    std::string directory;
+
+    SolutionCache() {
+        const char* configured = std::getenv("VRP_CACHE_DIR");
+        directory = configured != nullptr ? configured : "cache";
+    }
+
+    bool enabled() const {
+        return !directory.empty();
+    }
+
+    std::string key(uint64_t instance_hash, const std::string& solver, int capacity, int visits) const {
+        InstanceHasher hasher;
+        hasher.add(static_cast<int64_t>(FORMAT_VERSION));
+        hasher.add(static_cast<int64_t>(instance_hash));
+        hasher.add(solver);
+        hasher.add(static_cast<int64_t>(capacity));
+        hasher.add(static_cast<int64_t>(visits));
+        std::ostringstream text;
+        text << std::hex << std::setw(16) << std::setfill('0') << hasher.value;
+        return text.str();
+    }
+
+    bool load(const std::string& key, CachedResult& result) const {
+        if (!enabled()) {
+            return false;
+        }
+        std::ifstream file(pathOf(key));
+        if (!file.is_open()) {
+            return false;
+        }
+
+        std::string label;
+        int version, optimal;
+        size_t count;
+        file >> label >> version;
+        if (label != "cache" || version != FORMAT_VERSION) {
+            return false;
+        }
+        file >> label >> result.cost >> label >> optimal >> label >> count;
+        if (!file || count > (size_t(1) << 24)) {
+            return false;
+        }
+        result.optimal = optimal != 0;
+        result.path.assign(count, 0);
+        for (auto& node : result.path) {
+            file >> node;
+        }
+        return static_cast<bool>(file);
+    }
+
+    // Carrega a entrada e só a aceita se o caminho passar em validPath (com os limites inclusivos do
+    // modelo do chamador) e tiver o custo gravado. Uma entrada inválida é apagada, para que não impeça
+    // a gravação do resultado recalculado.
+    template <typename Net>
+    bool loadValid(const std::string& key, const Net& network, int max_load, int max_customers, CachedResult& result) const {
+        if (!load(key, result)) {
+            return false;
+        }
+        if (validPath(network, result.path, max_load, max_customers) && pathCost(network, result.path) == result.cost) {
+            return true;
+        }
+        std::cerr << "Entrada do cache inválida para esta instância, descartando (chave " << key << ")" << std::endl;
+        std::remove(pathOf(key).c_str());
+        return false;
+    }
+
+    // Grava o resultado se ele melhora a entrada existente. Escreve em um arquivo temporário e renomeia,
+    // como o checkpoint do ex1. Retorna true se a entrada foi gravada.
+    bool store(const std::string& key, const std::string& solver, int cost, bool optimal, const std::vector<int>& path) const {
+        if (!enabled() || path.empty()) {
+            return false;
+        }
+        CachedResult existing;
+        if (load(key, existing) && (existing.optimal || (!optimal && existing.cost <= cost))) {
+            return false;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        std::string temp_file = pathOf(key) + ".tmp";
+        std::ofstream file(temp_file);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao gravar no cache em '" << directory << "'" << std::endl;
+            return false;
+        }
+        file << "cache " << FORMAT_VERSION << std::endl;
+        file << "custo " << cost << std::endl;
+        file << "otimo " << (optimal ? 1 : 0) << std::endl;
+        file << "caminho " << path.size();
+        for (int node : path) {
+            file << " " << node;
+        }
+        file << std::endl;
+        file << "resolvedor " << solver << std::endl;
+        file.close();
+
+        return std::rename(temp_file.c_str(), pathOf(key).c_str()) == 0;
+    }
+
+    // Arquivo que guarda a entrada de 'key'.
+    std::string pathOf(const std::string& key) const {
+        return directory + "/" + key + ".txt";
+    }
+};
+
+#endif